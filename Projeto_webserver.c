@@ -25,10 +25,16 @@
 
 #include "hardware/i2c.h"        // Interface I2C
 #include "inc/ssd1306.h"         // Driver para display OLED
-#include "inc/font.h"            // Definies de fontes para o display
+#include "inc/painel.h"          // Widgets do display redesenhados s quando mudam
+#include "inc/sensores.h"        // Leitura dos sensores e retrato compartilhado
+#include "inc/historico.h"       // Histrico das leituras em memria fixa
 #include "hardware/pio.h"        // Funes de I/O programvel
 #include "hardware/clocks.h"     // Funes de controle de clock
-#include "animacoes_led.pio.h"   // Programa PIO para animaes de LED
+#include "inc/matriz_led.h"      // Envio dos quadros da matriz por DMA
+#include "inc/animacoes.h"       // Transies e animaes da matriz
+#include "inc/cores.h"           // Converso de cor e brilho com correo de gama
+#include "inc/layout_matriz.h"   // Cmodos e pixels de cada um na matriz
+#include "inc/ddp.h"             // Recepo de quadros da matriz por UDP
 
 // Credenciais da rede WiFi - Cuidado ao compartilhar publicamente!
 #define WIFI_SSID "**************"
@@ -39,6 +45,16 @@
 // Configurao da matriz de LEDs
 #define NUM_PIXELS 25           // Nmero de LEDs na matriz
 #define matriz_leds 7           // Pino de sada para a matriz
+#define DURACAO_TRANSICAO_MS 300 // Tempo do esmaecimento ao mudar um cmodo
+
+// Sadas de LEDs. Cada uma usa uma mquina de estados prpria e todas so
+// atualizadas em paralelo; fitas extras entram depois da matriz no quadro
+// (aumente MATRIZ_MAX_PIXELS para comport-las).
+static const matriz_saida_cfg_t saidas_led[] = {
+    { pio0, matriz_leds, NUM_PIXELS, MATRIZ_GRB, MATRIZ_WS2812 },   // Matriz 5x5
+    // { pio0, 2, 60, MATRIZ_GRBW, MATRIZ_SK6812 },              // Exemplo: fita RGBW no GPIO 2
+    // { pio1, 3, 60, MATRIZ_GRB, MATRIZ_WS2811 },               // Exemplo: fita WS2811 no GPIO 3
+};
 
 // Configurao I2C para o display OLED
 #define I2C_PORT i2c1           // Porta I2C utilizada
@@ -58,36 +74,77 @@
 #define TRIG_PIN 8              // Pino de trigger do sensor
 #define ECHO_PIN 9              // Pino de echo do sensor
 
-// Pino para o sensor de luz (LDR)
-#define ldr_pin 16
+// Pino para o sensor de luz (LDR) - entrada analgica ADC0
+#define ldr_pin 26
 
 // Variveis globais para controle dos dispositivos
-PIO pio;                       // Controlador PIO
-uint sm;                       // State Machine do PIO
 uint contagem = 5;             // Contador para exibio na matriz
 ssd1306_t ssd;                 // Estrutura do display OLED
 
-int tv = 0;
+// Telas do display OLED. As mudanas de estado vm do loop principal
+// (boto da pgina) e de um alarme, que encerra o aviso de TV desligada.
+// As telas so widgets (inc/painel.h): s o que muda  redesenhado.
+#define TELA_AVISO_DESLIGADA_MS 2000
+typedef enum {
+    TELA_STATUS,         // Temperatura, luzes e conexes, alternando com os grficos
+    TELA_LIGADA,         // "TELEVISO LIGADA"
+    TELA_DESLIGANDO      // "TELEVISO DESLIGADA" at o alarme voltar ao status
+} tela_estado_t;
+static volatile tela_estado_t tela_estado = TELA_STATUS;
+static volatile bool tela_mudou = true;
+static alarm_id_t alarme_tela = 0;
+// Prazo do aviso quando no h alarme livre; conferido no loop principal
+static absolute_time_t prazo_aviso;
+static bool aviso_sem_alarme = false;
+
+// Widgets de cada tela, criados em criar_telas
+static painel_id_t widgets_tv[4];
+static painel_id_t widgets_status[11];
+static painel_id_t widgets_graficos[6];
+static painel_id_t tv_estado, status_temperatura, status_luzes, status_num_luzes,
+                   status_ambiente, status_distancia, status_wifi, status_rede, status_ddp,
+                   grafico_temperatura, grafico_distancia, valor_temperatura, valor_distancia;
+
+// A tela de status alterna entre os valores e os grficos do histrico
+#define STATUS_TROCA_PAGINA_MS 5000
+static bool pagina_graficos = false;
+static absolute_time_t proxima_pagina;
+static bool envio_pendente = false;   // Regies desenhadas ainda no enviadas
 
 // Estados dos dispositivos (ligado/desligado)
-bool estado_led_sala = false;
-bool estado_led_cozinha = false;
-bool estado_led_quarto = false;
-bool estado_led_banheiro = false;
-bool estado_led_quintal = false;
+bool estado_comodo[NUM_COMODOS];   // Luz de cada cmodo (ver inc/layout_matriz.h)
 bool estado_display = false;
 
+// Cor (0xRRGGBB) e brilho (0 a 255) de cada cmodo na matriz
+uint32_t cor_comodo[NUM_COMODOS];
+uint8_t brilho_comodo[NUM_COMODOS];
+
+// Prximo instante de registro no histrico (uma amostra por segundo)
+absolute_time_t proxima_amostra_historico;
+
+// Exportaes do histrico em andamento, uma por conexo TCP
+#define MAX_EXPORTACOES 4
+typedef struct {
+    struct tcp_pcb *pcb;
+    hist_cursor_t cursor;
+    char pendente[256];        // Trecho formatado ainda no aceito pelo TCP
+    uint16_t tamanho_pendente;
+    bool em_uso;
+} exportacao_t;
+static exportacao_t exportacoes[MAX_EXPORTACOES];
+
 /* ========== PROTTIPOS DE FUNES ========== */
 void gpio_led_bitdog(void);    // Inicializa os GPIOs dos LEDs
 static err_t tcp_server_accept(void *arg, struct tcp_pcb *newpcb, err_t err); // Callback para conexes TCP
 static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err); // Callback para recebimento de dados
-float temp_read(void);         // L a temperatura interna
 void user_request(char **request); // Processa as requisies do usurio
+static void configurar_luz(const char *request); // Altera cor e brilho de um cmodo
 void ligar_luz();              // Controla a matriz de LEDs
+void criar_telas();            // Cria os widgets das telas do display
 void ligar_display();          // Controla o display OLED
-void send_trigger_pulse();     // Envia pulso para o sensor ultrassnico
-float measure_distance_cm();   // Mede a distncia com o sensor ultrassnico
 void luz_frente_controlada();  // Controla os LEDs frontais baseado em sensores
+void registrar_historico();    // Registra as leituras no histrico a cada segundo
+static void exportacao_iniciar(struct tcp_pcb *tpcb, const char *request); // Inicia a resposta de /api/history
 
 /* ========== IMPLEMENTAO DAS FUNES ========== */
 
@@ -99,11 +156,15 @@ int main() {
     // Inicializa os GPIOs dos LEDs
     gpio_led_bitdog();
 
+    // Cmodos comeam apagados, em branco e com brilho mximo
+    for (int i = 0; i < NUM_COMODOS; i++) {
+        cor_comodo[i] = 0xFFFFFF;
+        brilho_comodo[i] = 255;
+    }
+
     // Configurao do PIO para a matriz de LEDs
-    pio = pio0;
-    uint offset = pio_add_program(pio, &animacoes_led_program);
-    sm = pio_claim_unused_sm(pio, true);
-    animacoes_led_program_init(pio, sm, offset, matriz_leds);
+    matriz_init(saidas_led, count_of(saidas_led));
+    animacoes_init();
 
     // Configurao do I2C para o display OLED
     i2c_init(I2C_PORT, 400 * 1000);  // Inicializa I2C a 400kHz
@@ -118,6 +179,7 @@ int main() {
     ssd1306_send_data(&ssd);
     ssd1306_fill(&ssd, false);  // Limpa o display
     ssd1306_send_data(&ssd);
+    criar_telas();
 
     // Inicializa o chip WiFi
     while (cyw43_arch_init()) {
@@ -134,6 +196,7 @@ int main() {
 
     // Tenta conectar ao WiFi
     printf("Conectando ao Wi-Fi...\n");
+    animacoes_reproduzir(&animacao_conectando);
     while (cyw43_arch_wifi_connect_timeout_ms(WIFI_SSID, WIFI_PASSWORD, CYW43_AUTH_WPA2_AES_PSK, 20000)) {
         printf("Falha ao conectar ao Wi-Fi\n");
         sleep_ms(100);
@@ -164,16 +227,30 @@ int main() {
     tcp_accept(server, tcp_server_accept);
     printf("Servidor ouvindo na porta 80\n");
 
-    // Inicializa o ADC para leitura de temperatura
-    adc_init();
-    adc_set_temp_sensor_enabled(true);
+    // Recebe quadros da matriz enviados por programas de efeitos (DDP)
+    if (ddp_init(DDP_PORTA)) {
+        printf("Recebendo quadros DDP na porta UDP %d\n", DDP_PORTA);
+    }
+
+    // Inicializa o ADC e a leitura peridica dos sensores
+    sensores_init(TRIG_PIN, ECHO_PIN, ldr_pin);
+    proxima_amostra_historico = make_timeout_time_ms(1000);
 
     // Loop principal do programa
     while (true) {
+        // L os sensores cujo perodo venceu e publica o novo retrato
+        sensores_tarefa();
+
+        // Guarda as leituras no histrico
+        registrar_historico();
+
         // Controla os LEDs frontais baseado nos sensores
         luz_frente_controlada();
         
-        // Atualiza o estado da matriz de LEDs
+        // Atualiza o estado da matriz de LEDs. Durante um fluxo DDP a matriz
+        // mostra os quadros recebidos; ddp_ativo retoma as animaes quando
+        // o fluxo para.
+        ddp_ativo();
         ligar_luz();
         
         // Atualiza o display OLED
@@ -216,133 +293,202 @@ void gpio_led_bitdog(void) {
     gpio_init(ECHO_PIN);
     gpio_set_dir(ECHO_PIN, GPIO_IN);
 
-    // Configura o sensor de luz (LDR)
-    gpio_init(ldr_pin);
-    gpio_set_dir(ldr_pin, GPIO_IN);
+    // O sensor de luz (LDR)  configurado como entrada do ADC em sensores_init
 }
 
 /* ========== FUNES DE CONTROLE ========== */
 
 // Controla a matriz de LEDs baseado nos estados dos cmodos
 void ligar_luz() {
-    uint32_t luz_sala, luz_cozinha, luz_quarto, luz_banheiro, luz_quintal;
-
-    // Define as cores para cada cmodo baseado no estado
-    luz_sala = estado_led_sala ? 0xFFFFFF00 : 0x00000000;
-    luz_cozinha = estado_led_cozinha ? 0xFFFFFF00 : 0x00000000;
-    luz_quarto = estado_led_quarto ? 0xFFFFFF00 : 0x00000000;
-    luz_banheiro = estado_led_banheiro ? 0xFFFFFF00 : 0x00000000;
-    luz_quintal = estado_led_quintal ? 0xFFFFFF00 : 0x00000000;
-
-    // Atualiza cada LED da matriz 5x5
-    for (int i = 0; i < NUM_PIXELS; i++) {
-        uint32_t valor_led = 0;
-        int linha = i / 5;  // Divide a matriz em linhas
-        
-        // Atribui a cor baseado na linha (cmodo)
-        if (linha == 4) {
-            valor_led = luz_sala;
-        } else if (linha == 3) {
-            valor_led = luz_cozinha;
-        } else if (linha == 2) {
-            valor_led = luz_quarto;
-        } else if (linha == 1) {
-            valor_led = luz_banheiro;
-        } else if (linha == 0) {
-            valor_led = luz_quintal;
-        } else {
-            valor_led = 0x000000;  // LED apagado
+    static cor_fina_t quadro_anterior[MATRIZ_MAX_PIXELS];
+    static bool primeira_vez = true;
+    cor_fina_t quadro[MATRIZ_MAX_PIXELS] = { 0 };   // Pixels sem cmodo ficam apagados
+    cor_fina_t luz[NUM_COMODOS] = { 0 };
+
+    // Define a cor de cada cmodo baseado no estado. A cor fina guarda os
+    // nveis intermedirios de brilho que o dithering consegue mostrar.
+    for (int c = 0; c < NUM_COMODOS; c++) {
+        if (estado_comodo[c]) {
+            luz[c] = cores_rgb_para_fina(cor_comodo[c], brilho_comodo[c]);
         }
-        
-        // Envia o valor para o LED
-        pio_sm_put_blocking(pio, sm, valor_led);
     }
-}
 
-// Controla o display OLED
-void ligar_display() {
-    bool cor = true;  // Cor branca para o texto
-
-    // Limpa e desenha a moldura do display
-    ssd1306_fill(&ssd, !cor);
-    ssd1306_rect(&ssd, 0, 0, 127, 63, cor, !cor);    // Moldura externa
-    ssd1306_rect(&ssd, 3, 3, 122, 60, cor, !cor);    // Moldura interna
-
-    // Exibe o estado da TV
-    if (estado_display) {
-        // Limpa e desenha a moldura do display
-        ssd1306_fill(&ssd, !cor);
-        ssd1306_rect(&ssd, 0, 0, 127, 63, cor, !cor);    // Moldura externa
-        ssd1306_rect(&ssd, 3, 3, 122, 60, cor, !cor);    // Moldura interna
-        ssd1306_draw_string(&ssd, "TELEVISAO ", 35, 30);
-        ssd1306_draw_string(&ssd, "LIGADA", 38, 40);
-
-        // Atualiza o display
-        ssd1306_send_data(&ssd);
-
-        tv = 1;
-    } else {
-        if (tv == 1){
-            // Limpa e desenha a moldura do display
-        ssd1306_fill(&ssd, !cor);
-        ssd1306_rect(&ssd, 0, 0, 127, 63, cor, !cor);    // Moldura externa
-        ssd1306_rect(&ssd, 3, 3, 122, 60, cor, !cor);    // Moldura interna
-        ssd1306_draw_string(&ssd, "TELEVISAO ", 30, 30);
-        ssd1306_draw_string(&ssd, "DESLIGADA", 28, 40);
-
-        // Atualiza o display
-        ssd1306_send_data(&ssd);
-
-        sleep_ms(2000);
-
-        ssd1306_fill(&ssd, !cor);
-
-        // Atualiza o display
-        ssd1306_send_data(&ssd);
-
-        tv = 0;
+    // Monta o quadro pelas listas de pixels geradas na compilao, do ltimo
+    // cmodo para o primeiro: um pixel repetido fica com o primeiro. Nas
+    // sadas RGBW o branco comum aos trs canais vai para o LED branco.
+    for (int c = NUM_COMODOS - 1; c >= 0; c--) {
+        for (uint i = 0; i < pixels_comodo[c].quantidade; i++) {
+            uint p = pixels_comodo[c].pixels[i];
+            if (p >= MATRIZ_MAX_PIXELS) {
+                continue;
+            }
+            quadro[p] = luz[c];
+            if (matriz_formato_pixel(p) == MATRIZ_GRBW) {
+                quadro[p] = cores_fina_para_rgbw(luz[c]);
+            }
         }
     }
+
+    // S pede uma transio quando algum cmodo mudou; o motor de animaes
+    // faz o esmaecimento e envia os quadros por DMA
+    if (primeira_vez || memcmp(quadro, quadro_anterior, sizeof(quadro)) != 0) {
+        memcpy(quadro_anterior, quadro, sizeof(quadro));
+        animacoes_transicao(quadro, DURACAO_TRANSICAO_MS);
+        primeira_vez = false;
+    }
 }
 
-/* ========== FUNES DOS SENSORES ========== */
+// Fim do aviso de TV desligada: volta  tela de status
+static int64_t fim_aviso_desligada(alarm_id_t id, void *dados) {
+    if (tela_estado == TELA_DESLIGANDO) {
+        tela_estado = TELA_STATUS;
+        tela_mudou = true;
+    }
+    alarme_tela = 0;
+    return 0;
+}
 
-// Envia um pulso para o sensor ultrassnico
-void send_trigger_pulse() {
-    gpio_put(TRIG_PIN, 1);
-    sleep_us(10);
-    gpio_put(TRIG_PIN, 0);
+// cones de 8 linhas (uma coluna por byte, bit 0 em cima)
+static const uint8_t icone_termometro[] = { 0x60, 0xfe, 0xf9, 0xfe, 0x60 };
+static const uint8_t icone_wifi[] = { 0x02, 0x09, 0x05, 0x55, 0x05, 0x09, 0x02 };
+static const uint8_t icone_ddp[] = { 0x55, 0x00, 0x55, 0x00, 0x55, 0x00, 0x55 };
+
+void criar_telas() {
+    int n = 0;
+
+    painel_init(&ssd);
+
+    // TV: moldura dupla e texto centralizado
+    widgets_tv[0] = painel_moldura(0, 0, 127, 63);
+    widgets_tv[1] = painel_moldura(3, 3, 122, 60);
+    widgets_tv[2] = painel_rotulo(4, 30, 120, PAINEL_CENTRO, "TELEVISO");
+    widgets_tv[3] = tv_estado = painel_rotulo(4, 40, 120, PAINEL_CENTRO, "LIGADA");
+
+    // Status da casa
+    widgets_status[n++] = painel_icone(0, 0, icone_termometro, sizeof(icone_termometro));
+    widgets_status[n++] = painel_rotulo(8, 0, 64, PAINEL_ESQUERDA, "Temperatura");
+    widgets_status[n++] = status_temperatura = painel_valor(72, 0, 56, PAINEL_DIREITA, 1, " C");
+    widgets_status[n++] = painel_rotulo(0, 14, 44, PAINEL_ESQUERDA, "Luzes");
+    widgets_status[n++] = status_luzes = painel_barra(44, 14, 60, 8, 0, NUM_COMODOS);
+    widgets_status[n++] = status_num_luzes = painel_valor(104, 14, 24, PAINEL_DIREITA, 0, NULL);
+    widgets_status[n++] = painel_rotulo(0, 26, 44, PAINEL_ESQUERDA, "Ambiente");
+    widgets_status[n++] = status_ambiente = painel_barra(44, 26, 84, 8, 0, 4095);
+    widgets_status[n++] = painel_rotulo(0, 38, 44, PAINEL_ESQUERDA, "Distncia");
+    widgets_status[n++] = status_distancia = painel_valor(44, 38, 84, PAINEL_DIREITA, 1, " cm");
+    status_wifi = painel_icone(0, 54, icone_wifi, sizeof(icone_wifi));
+    widgets_status[n++] = status_rede = painel_rotulo(10, 54, 104, PAINEL_ESQUERDA, "sem rede");
+    status_ddp = painel_icone(121, 54, icone_ddp, sizeof(icone_ddp));
+
+    // Grficos das ltimas amostras do histrico (uma coluna por segundo),
+    // com escala automtica
+    n = 0;
+    widgets_graficos[n++] = painel_rotulo(0, 0, 64, PAINEL_ESQUERDA, "Temperatura");
+    widgets_graficos[n++] = valor_temperatura = painel_valor(64, 0, 64, PAINEL_DIREITA, 1, " C");
+    widgets_graficos[n++] = grafico_temperatura = painel_grafico(0, 8, 128, 24, 0, 0);
+    widgets_graficos[n++] = painel_rotulo(0, 32, 64, PAINEL_ESQUERDA, "Distncia");
+    widgets_graficos[n++] = valor_distancia = painel_valor(64, 32, 64, PAINEL_DIREITA, 1, " cm");
+    widgets_graficos[n++] = grafico_distancia = painel_grafico(0, 40, 128, 24, 0, 0);
+
+    proxima_pagina = make_timeout_time_ms(STATUS_TROCA_PAGINA_MS);
 }
 
-// Mede a distncia usando o sensor ultrassnico
-float measure_distance_cm() {
-    send_trigger_pulse();
+// Atualiza os valores da tela de status; os widgets ignoram o que no mudou
+static void atualizar_status() {
+    sensores_snapshot_t leitura;
+    sensores_ler(&leitura);
 
-    // Espera o pino ECHO ficar em HIGH
-    while (gpio_get(ECHO_PIN) == 0);
+    int ligados = 0;
+    for (int c = 0; c < NUM_COMODOS; c++) {
+        ligados += estado_comodo[c];
+    }
+
+    painel_definir_valor(status_temperatura, leitura.temperatura_centi / 10);
+    painel_definir_valor(valor_temperatura, leitura.temperatura_centi / 10);
+    painel_definir_valor(status_luzes, ligados);
+    painel_definir_valor(status_num_luzes, ligados);
+    painel_definir_valor(status_ambiente, leitura.luz);
+    painel_definir_valor(status_distancia, (int32_t)(leitura.distancia_cm * 10.0f));
+    painel_definir_valor(valor_distancia, (int32_t)(leitura.distancia_cm * 10.0f));
+
+    // Os cones de conexo dependem do estado, alm da tela atual
+    bool status = tela_estado == TELA_STATUS && !pagina_graficos;
+    bool conectado = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA) == CYW43_LINK_UP;
+    painel_visivel(status_wifi, status && conectado);
+    painel_texto(status_rede, conectado && netif_default ? ipaddr_ntoa(&netif_default->ip_addr) : "sem rede");
+    painel_visivel(status_ddp, status && ddp_ativo());
+}
 
-    // Marca o tempo de incio
-    absolute_time_t start = get_absolute_time();
+// Controla o display OLED. Nunca espera: o aviso de desligamento 
+// encerrado por um alarme e o envio  feito por DMA.
+void ligar_display() {
+    // Transies pedidas pela pgina
+    if (estado_display && tela_estado != TELA_LIGADA) {
+        if (alarme_tela > 0) {
+            cancel_alarm(alarme_tela);
+        }
+        alarme_tela = 0;
+        aviso_sem_alarme = false;
+        tela_estado = TELA_LIGADA;
+        tela_mudou = true;
+    } else if (!estado_display && tela_estado == TELA_LIGADA) {
+        tela_estado = TELA_DESLIGANDO;
+        tela_mudou = true;
+        alarm_id_t id = add_alarm_in_ms(TELA_AVISO_DESLIGADA_MS, fim_aviso_desligada, NULL, true);
+        if (id > 0) {
+            alarme_tela = id;
+        } else if (id < 0) {
+            // Sem alarme livre: o fim do aviso passa a ser conferido aqui
+            prazo_aviso = make_timeout_time_ms(TELA_AVISO_DESLIGADA_MS);
+            aviso_sem_alarme = true;
+        }
+    }
+    if (aviso_sem_alarme && time_reached(prazo_aviso)) {
+        aviso_sem_alarme = false;
+        fim_aviso_desligada(0, NULL);
+    }
 
-    // Espera o pino ECHO voltar para LOW
-    while (gpio_get(ECHO_PIN) == 1);
+    if (tela_estado == TELA_STATUS && time_reached(proxima_pagina)) {
+        proxima_pagina = make_timeout_time_ms(STATUS_TROCA_PAGINA_MS);
+        pagina_graficos = !pagina_graficos;
+        tela_mudou = true;
+    }
 
-    // Calcula a durao do pulso em microssegundos
-    absolute_time_t end = get_absolute_time();
-    int64_t pulse_duration = absolute_time_diff_us(start, end);
+    if (tela_mudou) {
+        tela_mudou = false;
+        bool tv = tela_estado != TELA_STATUS;
+        for (int i = 0; i < count_of(widgets_tv); i++) {
+            painel_visivel(widgets_tv[i], tv);
+        }
+        for (int i = 0; i < count_of(widgets_status); i++) {
+            painel_visivel(widgets_status[i], !tv && !pagina_graficos);
+        }
+        for (int i = 0; i < count_of(widgets_graficos); i++) {
+            painel_visivel(widgets_graficos[i], !tv && pagina_graficos);
+        }
+        painel_texto(tv_estado, tela_estado == TELA_LIGADA ? "LIGADA" : "DESLIGADA");
+    }
+    atualizar_status();
 
-    // Converte para centmetros (frmula padro para sensor HC-SR04)
-    float distance_cm = pulse_duration / 58.0;
+    if (painel_renderizar()) {
+        envio_pendente = true;
+    }
 
-    return distance_cm;
+    // Se o envio anterior ainda estiver em andamento, tenta de novo no
+    // prximo loop; as regies alteradas continuam marcadas
+    if (envio_pendente && ssd1306_send_data_async(&ssd)) {
+        envio_pendente = false;
+    }
 }
 
+/* ========== FUNES DOS SENSORES ========== */
+
 // Controla os LEDs frontais baseado nos sensores
 void luz_frente_controlada() {
-    float dist = measure_distance_cm();
+    sensores_snapshot_t leitura;
+    sensores_ler(&leitura);
     
     // Aciona os LEDs se houver objeto prximo e estiver escuro
-    if ((dist < 15) && (!gpio_get(ldr_pin))) {
+    if ((leitura.distancia_cm < 15) && leitura.escuro) {
         gpio_put(LED_BLUE_PIN, 1);
         gpio_put(LED_GREEN_PIN, 1);
         gpio_put(LED_RED_PIN, 1);
@@ -353,6 +499,43 @@ void luz_frente_controlada() {
     }
 }
 
+// Registra uma amostra por segundo no histrico. Se o loop atrasar, os
+// segundos perdidos recebem a ltima leitura para manter a escala de tempo.
+void registrar_historico() {
+    int16_t valores[HIST_NUM_SERIES];
+    sensores_snapshot_t leitura;
+    int limite = 10;
+
+    if (!time_reached(proxima_amostra_historico)) {
+        return;
+    }
+
+    sensores_ler(&leitura);
+
+    float distancia_mm = leitura.distancia_cm * 10.0f;
+    valores[HIST_TEMPERATURA] = leitura.temperatura_centi;
+    valores[HIST_DISTANCIA] = distancia_mm > INT16_MAX ? INT16_MAX : (int16_t)distancia_mm;
+    valores[HIST_LUZ] = leitura.luz;
+    valores[HIST_TELEVISAO] = estado_display ? 100 : 0;
+    for (int c = 0; c < NUM_COMODOS; c++) {
+        valores[HIST_COMODOS + c] = estado_comodo[c] ? 100 : 0;
+    }
+
+    while (time_reached(proxima_amostra_historico) && limite-- > 0) {
+        historico_amostrar(valores);
+
+        // Os grficos do display recebem cada amostra e desenham s a coluna nova
+        painel_grafico_adicionar(grafico_temperatura, valores[HIST_TEMPERATURA]);
+        painel_grafico_adicionar(grafico_distancia, valores[HIST_DISTANCIA]);
+        proxima_amostra_historico = delayed_by_ms(proxima_amostra_historico, 1000);
+    }
+
+    // Atraso muito grande: retoma a contagem a partir de agora
+    if (time_reached(proxima_amostra_historico)) {
+        proxima_amostra_historico = make_timeout_time_ms(1000);
+    }
+}
+
 /* ========== FUNES DE REDE ========== */
 
 // Callback para aceitar novas conexes TCP
@@ -363,25 +546,26 @@ static err_t tcp_server_accept(void *arg, struct tcp_pcb *newpcb, err_t err) {
 
 // Processa as requisies do usurio
 void user_request(char **request) {
+    const char *prefixo_luz = "GET /mudar_estado_luz_";
+    const char *comando_luz = strstr(*request, prefixo_luz);
+
     // Verifica qual comando foi recebido e altera o estado correspondente
-    if (strstr(*request, "GET /mudar_estado_luz_sala") != NULL) {
-        estado_led_sala = !estado_led_sala;
-    }
-    else if (strstr(*request, "GET /mudar_estado_luz_cozinha") != NULL) {
-        estado_led_cozinha = !estado_led_cozinha;
-    }
-    else if (strstr(*request, "GET /mudar_estado_luz_quarto") != NULL) {
-        estado_led_quarto = !estado_led_quarto;
-    }
-    else if (strstr(*request, "GET /mudar_estado_luz_banheiro") != NULL) {
-        estado_led_banheiro = !estado_led_banheiro;
-    }
-    else if (strstr(*request, "GET /mudar_estado_luz_quintal") != NULL) {
-        estado_led_quintal = !estado_led_quintal;
+    if (comando_luz != NULL) {
+        const char *nome = comando_luz + strlen(prefixo_luz);
+        for (int c = 0; c < NUM_COMODOS; c++) {
+            size_t n = strlen(nomes_comodos[c]);
+            if (strncmp(nome, nomes_comodos[c], n) == 0 && (nome[n] == ' ' || nome[n] == '?')) {
+                estado_comodo[c] = !estado_comodo[c];
+                break;
+            }
+        }
     }
     else if (strstr(*request, "GET /mudar_estado_display") != NULL) {
         estado_display = !estado_display;
     }
+    else if (strstr(*request, "GET /luz?") != NULL) {
+        configurar_luz(*request);
+    }
     else if (strstr(*request, "GET /on") != NULL) {
         cyw43_arch_gpio_put(LED_PIN, 1);
     }
@@ -390,21 +574,172 @@ void user_request(char **request) {
     }
 }
 
-// L a temperatura interna do RP2040
-float temp_read(void) {
-    adc_select_input(4);  // Seleciona o canal do sensor de temperatura
-    uint16_t raw_value = adc_read();
-    
-    // Frmula de converso para temperatura (documentao do RP2040)
-    const float conversion_factor = 3.3f / (1 << 12);
-    float temperature = 27.0f - ((raw_value * conversion_factor) - 0.706f) / 0.001721f;
-    
-    return temperature;
+// Copia o valor de um parmetro da query string ("nome=valor")
+static bool obter_parametro(const char *request, const char *nome, char *valor, size_t tamanho) {
+    size_t n = strlen(nome);
+    const char *p = strchr(request, '?');
+
+    while (p && *p != ' ' && *p != '\r' && *p != '\n') {
+        p++;
+        if (strncmp(p, nome, n) == 0 && p[n] == '=') {
+            p += n + 1;
+            size_t i = 0;
+            while (*p && *p != '&' && *p != ' ' && *p != '\r' && *p != '\n' && i + 1 < tamanho) {
+                valor[i++] = *p++;
+            }
+            valor[i] = '\0';
+            return true;
+        }
+        p = strpbrk(p, "& \r\n");
+    }
+    return false;
+}
+
+// Trata GET /luz?comodo=<nome>&brilho=<0-255>&cor=<RRGGBB>
+// Os parmetros brilho e cor so opcionais; o estado ligado/desligado no muda.
+static void configurar_luz(const char *request) {
+    char valor[16];
+    int comodo = -1;
+
+    if (obter_parametro(request, "comodo", valor, sizeof(valor))) {
+        for (int i = 0; i < NUM_COMODOS; i++) {
+            if (strcmp(valor, nomes_comodos[i]) == 0) {
+                comodo = i;
+                break;
+            }
+        }
+    }
+    if (comodo < 0) {
+        return;
+    }
+
+    if (obter_parametro(request, "brilho", valor, sizeof(valor))) {
+        long brilho = strtol(valor, NULL, 10);
+        brilho_comodo[comodo] = brilho < 0 ? 0 : brilho > 255 ? 255 : (uint8_t)brilho;
+    }
+    if (obter_parametro(request, "cor", valor, sizeof(valor))) {
+        cor_comodo[comodo] = strtoul(valor, NULL, 16) & 0xFFFFFF;
+    }
+}
+
+// Libera a exportao quando a conexo  perdida
+static void exportacao_erro(void *arg, err_t err) {
+    exportacao_t *e = (exportacao_t *)arg;
+    e->em_uso = false;
+}
+
+// Envia o que couber no buffer TCP e agenda o restante para o prximo ACK
+static void exportacao_continuar(exportacao_t *e) {
+    while (true) {
+        if (e->tamanho_pendente == 0) {
+            if (historico_cursor_concluido(&e->cursor)) {
+                break;
+            }
+            e->tamanho_pendente = historico_exportar_json(&e->cursor, e->pendente, sizeof(e->pendente));
+        }
+
+        if (e->tamanho_pendente > tcp_sndbuf(e->pcb) ||
+            tcp_write(e->pcb, e->pendente, e->tamanho_pendente, TCP_WRITE_FLAG_COPY) != ERR_OK) {
+            break;  // Sem espao: continua em exportacao_enviada
+        }
+        e->tamanho_pendente = 0;
+    }
+    tcp_output(e->pcb);
+
+    // Tudo enviado: encerra a conexo, o que marca o fim da resposta
+    if (e->tamanho_pendente == 0 && historico_cursor_concluido(&e->cursor)) {
+        tcp_arg(e->pcb, NULL);
+        tcp_sent(e->pcb, NULL);
+        tcp_err(e->pcb, NULL);
+        tcp_close(e->pcb);
+        e->em_uso = false;
+    }
+}
+
+// Callback chamado quando o cliente confirma dados enviados
+static err_t exportacao_enviada(void *arg, struct tcp_pcb *tpcb, u16_t len) {
+    exportacao_continuar((exportacao_t *)arg);
+    return ERR_OK;
+}
+
+// Trata GET /api/history?series=<serie>&res=<1s|1m|15m>
+static void exportacao_iniciar(struct tcp_pcb *tpcb, const char *request) {
+    static const char resposta_invalida[] =
+        "HTTP/1.1 400 Bad Request\r\n"
+        "Content-Type: text/plain\r\n"
+        "Connection: close\r\n"
+        "\r\n"
+        "Use /api/history?series=temperatura|distancia|luz|televisao|luz_<comodo>&res=1s|1m|15m\n";
+    static const char resposta_ocupado[] =
+        "HTTP/1.1 503 Service Unavailable\r\n"
+        "Content-Type: text/plain\r\n"
+        "Retry-After: 1\r\n"
+        "Connection: close\r\n"
+        "\r\n"
+        "Todas as exportacoes estao em andamento, tente novamente\n";
+    static const char cabecalho[] =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/json\r\n"
+        "Connection: close\r\n"
+        "\r\n";
+
+    char nome_serie[16], nome_res[8];
+    int serie = -1, res = HIST_RES_1S;
+    exportacao_t *e = NULL;
+
+    if (obter_parametro(request, "series", nome_serie, sizeof(nome_serie))) {
+        serie = historico_serie_de_nome(nome_serie);
+    }
+    if (obter_parametro(request, "res", nome_res, sizeof(nome_res))) {
+        res = historico_res_de_nome(nome_res);
+    }
+
+    for (int i = 0; i < MAX_EXPORTACOES; i++) {
+        if (!exportacoes[i].em_uso) {
+            e = &exportacoes[i];
+            break;
+        }
+    }
+
+    if (serie < 0 || res < 0) {
+        tcp_write(tpcb, resposta_invalida, sizeof(resposta_invalida) - 1, 0);
+        tcp_output(tpcb);
+        tcp_close(tpcb);
+        return;
+    }
+
+    // Parmetros vlidos, mas sem exportao livre
+    if (e == NULL) {
+        tcp_write(tpcb, resposta_ocupado, sizeof(resposta_ocupado) - 1, 0);
+        tcp_output(tpcb);
+        tcp_close(tpcb);
+        return;
+    }
+
+    e->em_uso = true;
+    e->pcb = tpcb;
+    e->tamanho_pendente = 0;
+    historico_cursor_iniciar(&e->cursor, (hist_serie_t)serie, (hist_res_t)res);
+
+    tcp_arg(tpcb, e);
+    tcp_sent(tpcb, exportacao_enviada);
+    tcp_err(tpcb, exportacao_erro);
+
+    tcp_write(tpcb, cabecalho, sizeof(cabecalho) - 1, 0);
+    exportacao_continuar(e);
 }
 
 // Callback para recebimento de dados TCP (requisies HTTP)
 static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
     if (!p) {
+        // O cliente fechou no meio de uma exportao: libera a exportao
+        exportacao_t *e = (exportacao_t *)arg;
+        if (e != NULL) {
+            tcp_arg(tpcb, NULL);
+            tcp_sent(tpcb, NULL);
+            tcp_err(tpcb, NULL);
+            e->em_uso = false;
+        }
         tcp_close(tpcb);
         tcp_recv(tpcb, NULL);
         return ERR_OK;
@@ -417,11 +752,23 @@ static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, er
 
     printf("Request: %s\n", request);
 
+    // A API de histrico responde em partes, conforme o TCP libera espao
+    if (strstr(request, "GET /api/history") != NULL) {
+        tcp_recved(tpcb, p->tot_len);
+        exportacao_iniciar(tpcb, request);
+        free(request);
+        pbuf_free(p);
+        return ERR_OK;
+    }
+
     // Processa a requisio do usurio
     user_request(&request);
     
-    // L a temperatura atual
-    float temperature = temp_read();
+    // Usa a ltima temperatura publicada pela tarefa de sensores
+    sensores_snapshot_t leitura;
+    sensores_ler(&leitura);
+    int temperatura = leitura.temperatura_centi;
+    int temperatura_abs = temperatura < 0 ? -temperatura : temperatura;
 
     // HTML da pgina web
     char html[2048];
@@ -448,10 +795,10 @@ static err_t tcp_server_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, er
              "<form action=\"./mudar_estado_luz_banheiro\"><button>Luz do Banheiro</button></form>\n"
              "<form action=\"./mudar_estado_luz_quintal\"><button>Luz do Quintal</button></form>\n"
              "<form action=\"./mudar_estado_display\"><button>Televiso</button></form>\n"
-              "<p class=\"temperature\">Temperatura Interna: %.2f &deg;C</p>\n"
+              "<p class=\"temperature\">Temperatura Interna: %s%d.%02d &deg;C</p>\n"
              "</body>\n"
              "</html>\n",
-             temperature);
+             temperatura < 0 ? "-" : "", temperatura_abs / 100, temperatura_abs % 100);
 
     // Envia a resposta HTTP
     tcp_write(tpcb, html, strlen(html), TCP_WRITE_FLAG_COPY);
@@ -0,0 +1,244 @@
+#include <string.h>
+#include "animacoes.h"
+#include "hardware/sync.h"
+
+#define PERIODO_MS (1000 / ANIM_FPS)
+
+// Cores usadas nos quadros-chave (GRB nos 24 bits superiores)
+#define AZUL_FRACO 0x00001000
+#define AZUL       0x00004000
+#define APAGADO    0x00000000
+
+/* ========== QUADROS-CHAVE EM FLASH ========== */
+
+// Pulso no centro da matriz que se espalha e some
+static const uint32_t quadro_centro[MATRIZ_MAX_PIXELS] = {
+    APAGADO, APAGADO,    APAGADO,    APAGADO,    APAGADO,
+    APAGADO, AZUL_FRACO, AZUL_FRACO, AZUL_FRACO, APAGADO,
+    APAGADO, AZUL_FRACO, AZUL,       AZUL_FRACO, APAGADO,
+    APAGADO, AZUL_FRACO, AZUL_FRACO, AZUL_FRACO, APAGADO,
+    APAGADO, APAGADO,    APAGADO,    APAGADO,    APAGADO,
+};
+static const uint32_t quadro_anel[MATRIZ_MAX_PIXELS] = {
+    AZUL_FRACO, AZUL_FRACO, AZUL_FRACO, AZUL_FRACO, AZUL_FRACO,
+    AZUL_FRACO, AZUL,       AZUL,       AZUL,       AZUL_FRACO,
+    AZUL_FRACO, AZUL,       APAGADO,    AZUL,       AZUL_FRACO,
+    AZUL_FRACO, AZUL,       AZUL,       AZUL,       AZUL_FRACO,
+    AZUL_FRACO, AZUL_FRACO, AZUL_FRACO, AZUL_FRACO, AZUL_FRACO,
+};
+static const uint32_t quadro_apagado[MATRIZ_MAX_PIXELS] = { 0 };
+
+static const anim_chave_t chaves_conectando[] = {
+    { quadro_centro,  400 },
+    { quadro_anel,    300 },
+    { quadro_apagado, 300 },
+    { quadro_apagado, 200 },
+};
+
+const animacao_t animacao_conectando = {
+    chaves_conectando, count_of(chaves_conectando), true
+};
+
+/* ========== ESTADO DO MOTOR ========== */
+
+static repeating_timer_t timer_animacao;
+
+// Quadro composto no último passo e extremos do segmento em andamento,
+// com 8 bits extras de precisão por canal
+static cor_fina_t saida[MATRIZ_MAX_PIXELS];
+static cor_fina_t origem[MATRIZ_MAX_PIXELS];
+static cor_fina_t destino[MATRIZ_MAX_PIXELS];
+static uint16_t duracao, decorrido;
+static bool segmento_ativo = false;
+
+#if ANIM_DITHERING
+// Resto acumulado de cada canal: a parte fracionária que ainda não virou
+// um degrau de 8 bits. Somado a cada quadro, faz a média no tempo bater
+// com o valor fino.
+static uint8_t resto[MATRIZ_MAX_PIXELS][4];
+#endif
+
+// Animação em reprodução (NULL durante uma transição simples)
+static const animacao_t *animacao_atual = NULL;
+static uint8_t chave_atual;
+
+// Pedido feito pelo loop principal, consumido no próximo passo do timer
+enum { PEDIDO_NENHUM, PEDIDO_TRANSICAO, PEDIDO_ANIMACAO };
+static volatile uint8_t pedido = PEDIDO_NENHUM;
+static cor_fina_t pedido_destino[MATRIZ_MAX_PIXELS];
+static uint16_t pedido_duracao;
+static const animacao_t *pedido_animacao;
+
+// Enquanto pausado, outra fonte (fluxo de rede) escreve o quadro da matriz.
+// Na retomada, o motor esmaece do que estiver na matriz até o seu destino.
+static volatile bool pausado = false;
+static bool em_pausa = false;
+
+// Interpola um canal 8.8 com fração f em Q8 (0 = a, 256 = b)
+static inline uint16_t interpolar(uint16_t a, uint16_t b, int32_t f) {
+    return (uint16_t)(a + (((int32_t)b - a) * f >> 8));
+}
+
+// Reduz um canal 8.8 aos 8 bits transmitidos
+#if ANIM_DITHERING
+static inline uint32_t quantizar(uint16_t v, uint8_t *r) {
+    uint32_t soma = *r + (v & 0xFF);
+    uint32_t c = (v >> 8) + (soma >> 8);
+    *r = (uint8_t)soma;
+    return c > 255 ? 255 : c;
+}
+#else
+static inline uint32_t quantizar(uint16_t v) {
+    uint32_t c = (v + 0x80u) >> 8;
+    return c > 255 ? 255 : c;
+}
+#endif
+
+static void iniciar_segmento(uint16_t duracao_ms) {
+    memcpy(origem, saida, sizeof(origem));
+    duracao = duracao_ms;
+    decorrido = 0;
+    segmento_ativo = true;
+}
+
+// Os quadros-chave ficam em flash como palavras de 8 bits por canal
+static void destino_de_palavras(const uint32_t *quadro) {
+    for (int i = 0; i < MATRIZ_MAX_PIXELS; i++) {
+        destino[i] = cores_palavra_para_fina(quadro[i]);
+    }
+}
+
+static void consumir_pedido(void) {
+    if (pedido == PEDIDO_TRANSICAO) {
+        animacao_atual = NULL;
+        memcpy(destino, pedido_destino, sizeof(destino));
+        iniciar_segmento(pedido_duracao);
+    } else if (pedido == PEDIDO_ANIMACAO) {
+        animacao_atual = pedido_animacao;
+        chave_atual = 0;
+        destino_de_palavras(animacao_atual->chaves[0].quadro);
+        iniciar_segmento(animacao_atual->chaves[0].duracao_ms);
+    }
+    pedido = PEDIDO_NENHUM;
+}
+
+// Fim de um segmento: avança para o próximo quadro-chave ou para
+static void proximo_segmento(void) {
+    if (animacao_atual == NULL) {
+        segmento_ativo = false;
+        return;
+    }
+
+    chave_atual++;
+    if (chave_atual >= animacao_atual->num_chaves) {
+        if (!animacao_atual->repetir) {
+            animacao_atual = NULL;
+            segmento_ativo = false;
+            return;
+        }
+        chave_atual = 0;
+    }
+
+    const anim_chave_t *chave = &animacao_atual->chaves[chave_atual];
+    destino_de_palavras(chave->quadro);
+    iniciar_segmento(chave->duracao_ms);
+}
+
+// Recomeça o segmento atual a partir do quadro exibido na matriz
+static void retomar(void) {
+    const uint32_t *quadro = matriz_quadro();
+    for (int i = 0; i < MATRIZ_MAX_PIXELS; i++) {
+        saida[i] = cores_palavra_para_fina(quadro[i]);
+    }
+    memcpy(origem, saida, sizeof(origem));
+    if (!segmento_ativo) {
+        duracao = ANIM_DURACAO_RETOMADA_MS;
+        segmento_ativo = true;
+    }
+    decorrido = 0;
+}
+
+// Passo do motor, executado pelo timer a ANIM_FPS. Com o dithering ligado
+// o quadro é recomposto a todo passo, mesmo parado; sem ele, só durante
+// uma transição ou animação.
+static bool passo_animacao(repeating_timer_t *t) {
+    if (pedido != PEDIDO_NENHUM) {
+        consumir_pedido();
+    }
+
+    if (pausado) {
+        em_pausa = true;
+        return true;
+    }
+    if (em_pausa) {
+        em_pausa = false;
+        retomar();
+    }
+
+    // Quadro anterior ainda em envio, ou nada a fazer
+    if (matriz_ocupada() || (!segmento_ativo && !ANIM_DITHERING)) {
+        return true;
+    }
+
+    int32_t f = 0;
+    if (segmento_ativo) {
+        decorrido += PERIODO_MS;
+        f = decorrido >= duracao ? 256 : ((int32_t)decorrido << 8) / duracao;
+    }
+
+    uint32_t *quadro = matriz_quadro();
+    uint n = matriz_num_pixels();
+    for (uint i = 0; i < n; i++) {
+        if (segmento_ativo) {
+            saida[i].g = interpolar(origem[i].g, destino[i].g, f);
+            saida[i].r = interpolar(origem[i].r, destino[i].r, f);
+            saida[i].b = interpolar(origem[i].b, destino[i].b, f);
+            saida[i].w = interpolar(origem[i].w, destino[i].w, f);
+        }
+#if ANIM_DITHERING
+        quadro[i] = (quantizar(saida[i].g, &resto[i][0]) << 24) |
+                    (quantizar(saida[i].r, &resto[i][1]) << 16) |
+                    (quantizar(saida[i].b, &resto[i][2]) << 8) |
+                    quantizar(saida[i].w, &resto[i][3]);
+#else
+        quadro[i] = (quantizar(saida[i].g) << 24) | (quantizar(saida[i].r) << 16) |
+                    (quantizar(saida[i].b) << 8) | quantizar(saida[i].w);
+#endif
+    }
+    matriz_enviar();
+
+    if (f == 256) {
+        proximo_segmento();
+    }
+    return true;
+}
+
+/* ========== INTERFACE ========== */
+
+// Inicia o timer que avança as animações independentemente do loop principal
+void animacoes_init(void) {
+    add_repeating_timer_ms(-PERIODO_MS, passo_animacao, NULL, &timer_animacao);
+}
+
+// Faz a matriz passar suavemente do quadro atual para "alvo"
+void animacoes_transicao(const cor_fina_t *alvo, uint16_t duracao_ms) {
+    uint32_t estado = save_and_disable_interrupts();
+    memcpy(pedido_destino, alvo, sizeof(pedido_destino));
+    pedido_duracao = duracao_ms;
+    pedido = PEDIDO_TRANSICAO;
+    restore_interrupts(estado);
+}
+
+// Reproduz uma sequência de quadros-chave a partir do quadro atual
+void animacoes_reproduzir(const animacao_t *animacao) {
+    uint32_t estado = save_and_disable_interrupts();
+    pedido_animacao = animacao;
+    pedido = PEDIDO_ANIMACAO;
+    restore_interrupts(estado);
+}
+
+// Suspende ou retoma a escrita do motor na matriz. Pedidos feitos durante
+// a pausa não se perdem: o último destino é alcançado na retomada.
+void animacoes_pausar(bool pausar) {
+    pausado = pausar;
+}
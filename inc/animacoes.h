@@ -0,0 +1,47 @@
+#ifndef ANIMACOES_H
+#define ANIMACOES_H
+
+#include "pico/stdlib.h"
+#include "matriz_led.h"
+#include "cores.h"
+
+// Dithering temporal: o motor trabalha com 8 bits extras por canal e
+// distribui a parte fracionária ao longo dos quadros, suavizando os níveis
+// baixos de brilho. Exige uma taxa de atualização fixa e alta.
+#ifndef ANIM_DITHERING
+#define ANIM_DITHERING 1
+#endif
+
+// Taxa de atualização do motor de animações (quadros por segundo). Com 25
+// LEDs um quadro leva cerca de 1,3 ms no fio, então 200 Hz cabe com folga.
+#if ANIM_DITHERING
+#define ANIM_FPS 200
+#else
+#define ANIM_FPS 50
+#endif
+
+// Duração do esmaecimento de volta ao destino após uma pausa
+#define ANIM_DURACAO_RETOMADA_MS 500
+
+// Quadro-chave: o quadro a alcançar e o tempo da interpolação até ele
+typedef struct {
+    const uint32_t *quadro;    // Palavras GRB de cada LED, guardadas em flash
+    uint16_t duracao_ms;
+} anim_chave_t;
+
+// Sequência de quadros-chave, reproduzida a partir do quadro atual
+typedef struct {
+    const anim_chave_t *chaves;
+    uint8_t num_chaves;
+    bool repetir;
+} animacao_t;
+
+// Animação exibida enquanto o Wi-Fi conecta
+extern const animacao_t animacao_conectando;
+
+void animacoes_init(void);
+void animacoes_transicao(const cor_fina_t *destino, uint16_t duracao_ms);
+void animacoes_reproduzir(const animacao_t *animacao);
+void animacoes_pausar(bool pausar);
+
+#endif
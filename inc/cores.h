@@ -0,0 +1,66 @@
+#ifndef CORES_H
+#define CORES_H
+
+#include <stdint.h>
+#include "gamma_lut.h"
+
+// Cor com 8 bits extras de precisão por canal (ponto fixo 8.8), usada pelo
+// motor de animações antes do dithering temporal
+typedef struct {
+    uint16_t g, r, b, w;
+} cor_fina_t;
+
+// Aplica brilho (escala Q16 de escala_lut) e gama a um canal de 8 bits sem
+// arredondar: a posição na tabela de gama é interpolada com a parte
+// fracionária do canal já escalado. O resultado fica em ponto fixo 8.8.
+static inline uint16_t cores_canal_fino(uint32_t canal, uint32_t escala) {
+    uint32_t x = canal * escala;            // Canal em Q16
+    uint32_t i = x >> 16;
+    uint32_t f = (x >> 8) & 0xFF;
+
+    if (i >= 255) {
+        return gamma16_lut[255];
+    }
+    return (uint16_t)(gamma16_lut[i] + (((gamma16_lut[i + 1] - gamma16_lut[i]) * f) >> 8));
+}
+
+// Converte uma cor RGB (0xRRGGBB) com brilho de 0 a 255 para a forma fina,
+// com a precisão extra usada pelo dithering
+static inline cor_fina_t cores_rgb_para_fina(uint32_t rgb, uint8_t brilho) {
+    uint32_t escala = escala_lut[brilho];
+    cor_fina_t cor = {
+        .g = cores_canal_fino((rgb >> 8) & 0xFF, escala),
+        .r = cores_canal_fino((rgb >> 16) & 0xFF, escala),
+        .b = cores_canal_fino(rgb & 0xFF, escala),
+        .w = 0,
+    };
+    return cor;
+}
+
+// Para fitas RGBW: a parte comum aos três canais vai para o LED branco, que
+// produz a mesma luz com bem menos consumo
+static inline cor_fina_t cores_fina_para_rgbw(cor_fina_t cor) {
+    uint16_t w = cor.r < cor.g ? cor.r : cor.g;
+    if (cor.b < w) {
+        w = cor.b;
+    }
+
+    cor.g -= w;
+    cor.r -= w;
+    cor.b -= w;
+    cor.w = w;
+    return cor;
+}
+
+// Converte uma palavra GRB(W) do quadro para a forma fina
+static inline cor_fina_t cores_palavra_para_fina(uint32_t palavra) {
+    cor_fina_t cor = {
+        .g = (uint16_t)((palavra >> 24) << 8),
+        .r = (uint16_t)(((palavra >> 16) & 0xFF) << 8),
+        .b = (uint16_t)(((palavra >> 8) & 0xFF) << 8),
+        .w = (uint16_t)((palavra & 0xFF) << 8),
+    };
+    return cor;
+}
+
+#endif
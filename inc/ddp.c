@@ -0,0 +1,200 @@
+#include <string.h>
+#include "ddp.h"
+#include "matriz_led.h"
+#include "animacoes.h"
+#include "hardware/sync.h"
+#include "lwip/udp.h"
+
+// Cabeçalho DDP: flags, sequência, tipo, destino, deslocamento (32 bits) e
+// tamanho (16 bits), em big-endian. Com timecode, vem mais 4 bytes.
+#define DDP_CABECALHO        10
+#define DDP_CABECALHO_TC     14
+
+#define DDP_VERSAO_MASCARA   0xC0
+#define DDP_VERSAO_1         0x40
+#define DDP_FLAG_TIMECODE    0x10
+#define DDP_FLAG_CONSULTA    0x02
+#define DDP_FLAG_PUSH        0x01
+
+#define DDP_TIPO_INDEFINIDO  0x00   // Tratado como RGB de 8 bits
+#define DDP_TIPO_RGB8        0x0B
+#define DDP_TIPO_RGBW8       0x1B
+
+#define DDP_ID_DISPLAY       1
+
+// Posição de cada canal recebido dentro da palavra do quadro (little-endian):
+// G no byte 3, R no 2, B no 1 e o branco no 0
+static const uint8_t byte_rgb[3] = { 2, 3, 1 };
+static const uint8_t byte_rgbw[4] = { 2, 3, 1, 0 };
+
+static struct udp_pcb *pcb_ddp;
+static ddp_estatisticas_t estatisticas;
+
+// Próxima sequência esperada (1 a 15; 0 = ainda sem referência)
+static uint8_t sequencia_esperada = 0;
+static volatile uint32_t ultimo_pacote_ms;
+static volatile bool recebeu = false;
+
+// Confere a sequência do pacote. Com 4 bits não há como distinguir uma
+// perda longa de um atraso, então saltos de até metade do ciclo contam como
+// perdas e o resto como pacote fora de ordem.
+static bool conferir_sequencia(uint8_t seq) {
+    if (seq == 0) {
+        return true;   // Remetente não numera os pacotes
+    }
+
+    if (sequencia_esperada != 0 && seq != sequencia_esperada) {
+        uint8_t salto = (uint8_t)((seq + 15 - sequencia_esperada) % 15);
+        if (salto > 7) {
+            estatisticas.fora_de_ordem++;
+            return false;
+        }
+        estatisticas.perdidos += salto;
+    }
+
+    sequencia_esperada = seq % 15 + 1;
+    return true;
+}
+
+// Escreve os canais recebidos direto nos bytes das palavras do quadro,
+// percorrendo a cadeia de pbufs sem cópia intermediária
+static void escrever_pixels(const struct pbuf *p, uint16_t inicio, uint32_t deslocamento,
+                            uint16_t tamanho, const uint8_t *posicoes, uint canais) {
+    uint8_t *destino = (uint8_t *)matriz_quadro();
+    uint32_t limite = matriz_num_pixels() * canais;
+    uint32_t pixel = deslocamento / canais;
+    uint canal = deslocamento % canais;
+
+    if (deslocamento >= limite) {
+        return;
+    }
+    if (tamanho > limite - deslocamento) {
+        tamanho = (uint16_t)(limite - deslocamento);
+    }
+
+    for (; p != NULL && tamanho > 0; p = p->next) {
+        if (inicio >= p->len) {
+            inicio -= p->len;
+            continue;
+        }
+
+        const uint8_t *dados = (const uint8_t *)p->payload + inicio;
+        uint16_t n = p->len - inicio;
+        if (n > tamanho) {
+            n = tamanho;
+        }
+        inicio = 0;
+        tamanho -= n;
+
+        while (n--) {
+            destino[pixel * 4 + posicoes[canal]] = *dados++;
+            if (++canal == canais) {
+                canal = 0;
+                pixel++;
+            }
+        }
+    }
+}
+
+static void ddp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t porta) {
+    if (p == NULL) {
+        return;
+    }
+
+    uint8_t cab[DDP_CABECALHO_TC];
+    uint16_t lidos = pbuf_copy_partial(p, cab, sizeof(cab), 0);
+    uint16_t tam_cab = (cab[0] & DDP_FLAG_TIMECODE) ? DDP_CABECALHO_TC : DDP_CABECALHO;
+
+    if (lidos < tam_cab || (cab[0] & DDP_VERSAO_MASCARA) != DDP_VERSAO_1 ||
+        (cab[0] & DDP_FLAG_CONSULTA) || cab[3] != DDP_ID_DISPLAY) {
+        estatisticas.invalidos++;
+        pbuf_free(p);
+        return;
+    }
+
+    const uint8_t *posicoes;
+    uint canais;
+    if (cab[2] == DDP_TIPO_INDEFINIDO || cab[2] == DDP_TIPO_RGB8) {
+        posicoes = byte_rgb;
+        canais = 3;
+    } else if (cab[2] == DDP_TIPO_RGBW8) {
+        posicoes = byte_rgbw;
+        canais = 4;
+    } else {
+        estatisticas.invalidos++;
+        pbuf_free(p);
+        return;
+    }
+
+    uint32_t deslocamento = ((uint32_t)cab[4] << 24) | ((uint32_t)cab[5] << 16) |
+                            ((uint32_t)cab[6] << 8) | cab[7];
+    uint16_t tamanho = (uint16_t)((cab[8] << 8) | cab[9]);
+    if (tamanho > p->tot_len - tam_cab) {
+        estatisticas.invalidos++;
+        pbuf_free(p);
+        return;
+    }
+
+    if (!conferir_sequencia(cab[1] & 0x0F)) {
+        pbuf_free(p);
+        return;
+    }
+
+    // A partir do primeiro pacote a matriz passa a seguir o fluxo
+    ultimo_pacote_ms = to_ms_since_boot(get_absolute_time());
+    recebeu = true;
+    animacoes_pausar(true);
+    estatisticas.pacotes++;
+
+    // Os pixels vão para o quadro de trás, livre mesmo durante um envio.
+    // Um quadro que não pôde ser publicado segue no quadro de trás e sai
+    // junto com o próximo PUSH.
+    escrever_pixels(p, tam_cab, deslocamento, tamanho, posicoes, canais);
+    if (cab[0] & DDP_FLAG_PUSH) {
+        if (matriz_enviar()) {
+            estatisticas.quadros++;
+        } else {
+            estatisticas.descartados++;
+        }
+    }
+
+    pbuf_free(p);
+}
+
+// Abre a porta UDP e passa a aceitar quadros
+bool ddp_init(uint16_t porta) {
+    pcb_ddp = udp_new();
+    if (pcb_ddp == NULL) {
+        return false;
+    }
+    if (udp_bind(pcb_ddp, IP_ADDR_ANY, porta) != ERR_OK) {
+        return false;
+    }
+    udp_recv(pcb_ddp, ddp_recv, NULL);
+    return true;
+}
+
+// Verdadeiro enquanto chegam pacotes com intervalo menor que DDP_TIMEOUT_MS.
+// A pausa das animações é ligada pelo primeiro pacote e desligada só aqui,
+// quando o tempo se esgota. A verificação roda com as interrupções
+// desligadas, pois ddp_recv pode chegar no meio dela.
+bool ddp_ativo(void) {
+    if (!recebeu) {
+        return false;
+    }
+    uint32_t estado = save_and_disable_interrupts();
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+    bool ativo = agora_ms - ultimo_pacote_ms < DDP_TIMEOUT_MS;
+    if (!ativo) {
+        recebeu = false;
+        sequencia_esperada = 0;
+        animacoes_pausar(false);
+    }
+    restore_interrupts(estado);
+    return ativo;
+}
+
+// Copia os contadores de recepção
+void ddp_estatisticas(ddp_estatisticas_t *destino) {
+    *destino = estatisticas;
+}
@@ -0,0 +1,28 @@
+#ifndef DDP_H
+#define DDP_H
+
+#include "pico/stdlib.h"
+
+// Recepção de quadros pelo protocolo DDP (Distributed Display Protocol),
+// aceito por xLights, WLED, LedFx e similares. Os pixels chegam por UDP e
+// são escritos direto no quadro da matriz.
+#define DDP_PORTA       4048
+
+// Sem pacotes por este tempo, a matriz volta a mostrar os cômodos
+#define DDP_TIMEOUT_MS  2000
+
+// Contadores desde o boot
+typedef struct {
+    uint32_t pacotes;           // Pacotes de dados aceitos
+    uint32_t quadros;           // Quadros enviados à matriz (pacotes com PUSH)
+    uint32_t perdidos;          // Pacotes que faltaram na sequência
+    uint32_t fora_de_ordem;     // Pacotes atrasados ou repetidos, descartados
+    uint32_t descartados;       // Quadros não publicados com a matriz em envio
+    uint32_t invalidos;         // Pacotes malformados ou de tipo não suportado
+} ddp_estatisticas_t;
+
+bool ddp_init(uint16_t porta);
+bool ddp_ativo(void);
+void ddp_estatisticas(ddp_estatisticas_t *destino);
+
+#endif
@@ -1,70 +1,473 @@
+// Arquivo gerado por tools/gerar_fonte.py - nao editar manualmente.
+// Fonte proporcional de 8 pixels de altura: ASCII imprimivel e Latin-1.
+// Cada byte e uma coluna com o bit 0 em cima, no formato das paginas do SSD1306.
 
-// Fontes para A-Z e 0-9. Os caracteres tem 8x8 pixels
+#ifndef FONT_H
+#define FONT_H
 
+#include <stdint.h>
 
-static uint8_t font[] = {
-0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
-0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00, //0
-0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00, //1
-0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00, //2
-0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, //3
-0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00, //4
-0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, //5
-0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, //6
-0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, //7
-0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, //8
-0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, //9
-0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, //A
-0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, //B
-0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00, //C
-0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00, //D
-0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00, //E
-0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00, //F
-0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00, //G
-0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00, //H
-0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, //I
-0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00, //J
-0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00, //K
-0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, //L
-0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00, //M
-0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00, //N
-0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00, //O
-0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00, //P
-0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00, //Q
-0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00, //R
-0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00, //S
-0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00, //T
-0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00, //U
-0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00, //V
-0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00, //W
-0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00, //X
-0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00, //Y
-0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00, //Z
-0x00, 0x18, 0x24, 0x24, 0x24, 0x3C, 0x00, 0x00, // a
-0x00, 0x7E, 0x24, 0x24, 0x24, 0x24, 0x18, 0x00, // b
-0x00, 0x1C, 0x22, 0x22, 0x22, 0x22, 0x00, 0x00, // c
-0x00, 0x18, 0x24, 0x24, 0x24, 0x24, 0x7E, 0x00, // d
-0x00, 0x1C, 0x22, 0x2E, 0x2A, 0x2A, 0x1C, 0x00, // e
-0x00, 0x08, 0x7E, 0x09, 0x01, 0x02, 0x00, 0x00, // f
-0x00, 0x18, 0xA4, 0xA4, 0xA4, 0x9C, 0x78, 0x00, // g
-0x00, 0x7E, 0x08, 0x04, 0x04, 0x3C, 0x20, 0x00, // h
-0x00, 0x00, 0x24, 0x3D, 0x20, 0x00, 0x00, 0x00, // i
-0x00, 0x00, 0x40, 0x80, 0x84, 0x7D, 0x00, 0x00, // j
-0x00, 0x7E, 0x08, 0x14, 0x24, 0x20, 0x00, 0x00, // k
-0x00, 0x00, 0x02, 0x7E, 0x20, 0x00, 0x00, 0x00, // l
-0x00, 0x3C, 0x04, 0x18, 0x04, 0x3C, 0x00, 0x00, // m
-0x00, 0x3C, 0x08, 0x04, 0x04, 0x3C, 0x00, 0x00, // n
-0x00, 0x18, 0x24, 0x24, 0x24, 0x24, 0x18, 0x00, // o
-0x00, 0xFC, 0x24, 0x24, 0x24, 0x18, 0x00, 0x00, // p
-0x00, 0x18, 0x24, 0x24, 0x24, 0x28, 0xFC, 0x00, // q
-0x00, 0x3C, 0x08, 0x04, 0x04, 0x08, 0x00, 0x00, // r
-0x00, 0x28, 0x2C, 0x34, 0x34, 0x14, 0x00, 0x00, // s
-0x00, 0x04, 0x1E, 0x24, 0x20, 0x10, 0x00, 0x00, // t
-0x00, 0x1C, 0x20, 0x20, 0x20, 0x3C, 0x00, 0x00, // u
-0x00, 0x0C, 0x10, 0x20, 0x10, 0x0C, 0x00, 0x00, // v
-0x00, 0x3C, 0x10, 0x08, 0x10, 0x3C, 0x00, 0x00, // w
-0x00, 0x24, 0x18, 0x18, 0x24, 0x00, 0x00, 0x00, // x
-0x00, 0x1C, 0xA0, 0xA0, 0xA0, 0x7C, 0x00, 0x00, // y
-0x00, 0x24, 0x34, 0x2C, 0x24, 0x24, 0x00, 0x00  // z
+#define FONTE_ALTURA 8
+#define FONTE_ESPACAMENTO 1   // Coluna vazia entre caracteres
 
+// Posicao das colunas de um glifo em fonte_colunas e sua largura
+typedef struct {
+  uint16_t inicio;
+  uint8_t largura;
+} fonte_glifo_t;
+
+static const uint8_t fonte_colunas[964] = {
+    0x00, 0x00,  // ' '
+    0x5f,  // '!'
+    0x03, 0x00, 0x03,  // '"'
+    0x14, 0x3e, 0x14, 0x3e, 0x14,  // '#'
+    0x24, 0x2a, 0x7f, 0x2a, 0x12,  // '$'
+    0x26, 0x16, 0x08, 0x34, 0x32,  // '%'
+    0x36, 0x49, 0x55, 0x22, 0x50,  // '&'
+    0x03,  // '''
+    0x3e, 0x41,  // '('
+    0x41, 0x3e,  // ')'
+    0x0a, 0x04, 0x0e, 0x04, 0x0a,  // '*'
+    0x08, 0x08, 0x3e, 0x08, 0x08,  // '+'
+    0x80, 0x60,  // ','
+    0x08, 0x08, 0x08, 0x08,  // '-'
+    0x40,  // '.'
+    0x20, 0x10, 0x08, 0x04, 0x02,  // '/'
+    0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e,  // '0'
+    0x42, 0x7f, 0x40,  // '1'
+    0x30, 0x49, 0x49, 0x49, 0x49, 0x46,  // '2'
+    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36,  // '3'
+    0x3f, 0x20, 0x20, 0x78, 0x20, 0x20,  // '4'
+    0x4f, 0x49, 0x49, 0x49, 0x49, 0x30,  // '5'
+    0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30,  // '6'
+    0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03,  // '7'
+    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36,  // '8'
+    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f,  // '9'
+    0x24,  // ':'
+    0x40, 0x24,  // ';'
+    0x08, 0x14, 0x22, 0x41,  // '<'
+    0x14, 0x14, 0x14, 0x14,  // '='
+    0x41, 0x22, 0x14, 0x08,  // '>'
+    0x02, 0x01, 0x51, 0x09, 0x06,  // '?'
+    0x3e, 0x41, 0x5d, 0x55, 0x5e,  // '@'
+    0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78,  // 'A'
+    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f,  // 'B'
+    0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,  // 'C'
+    0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e,  // 'D'
+    0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49,  // 'E'
+    0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01,  // 'F'
+    0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73,  // 'G'
+    0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f,  // 'H'
+    0x7f,  // 'I'
+    0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01,  // 'J'
+    0x7f, 0x08, 0x08, 0x14, 0x22, 0x41,  // 'K'
+    0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40,  // 'L'
+    0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f,  // 'M'
+    0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f,  // 'N'
+    0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e,  // 'O'
+    0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e,  // 'P'
+    0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e,  // 'Q'
+    0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e,  // 'R'
+    0x46, 0x49, 0x49, 0x49, 0x49, 0x30,  // 'S'
+    0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01,  // 'T'
+    0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f,  // 'U'
+    0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f,  // 'V'
+    0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f,  // 'W'
+    0x41, 0x22, 0x14, 0x14, 0x22, 0x41,  // 'X'
+    0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01,  // 'Y'
+    0x41, 0x61, 0x59, 0x45, 0x43, 0x41,  // 'Z'
+    0x7f, 0x41,  // '['
+    0x02, 0x04, 0x08, 0x10, 0x20,  // '\\'
+    0x41, 0x7f,  // ']'
+    0x04, 0x02, 0x01, 0x02, 0x04,  // '^'
+    0x80, 0x80, 0x80, 0x80, 0x80,  // '_'
+    0x01, 0x02,  // '`'
+    0x18, 0x24, 0x24, 0x24, 0x3c,  // 'a'
+    0x7e, 0x24, 0x24, 0x24, 0x24, 0x18,  // 'b'
+    0x1c, 0x22, 0x22, 0x22, 0x22,  // 'c'
+    0x18, 0x24, 0x24, 0x24, 0x24, 0x7e,  // 'd'
+    0x1c, 0x22, 0x2e, 0x2a, 0x2a, 0x1c,  // 'e'
+    0x08, 0x7e, 0x09, 0x01, 0x02,  // 'f'
+    0x18, 0xa4, 0xa4, 0xa4, 0x9c, 0x78,  // 'g'
+    0x7e, 0x08, 0x04, 0x04, 0x3c, 0x20,  // 'h'
+    0x24, 0x3d, 0x20,  // 'i'
+    0x40, 0x80, 0x84, 0x7d,  // 'j'
+    0x7e, 0x08, 0x14, 0x24, 0x20,  // 'k'
+    0x02, 0x7e, 0x20,  // 'l'
+    0x3c, 0x04, 0x18, 0x04, 0x3c,  // 'm'
+    0x3c, 0x08, 0x04, 0x04, 0x3c,  // 'n'
+    0x18, 0x24, 0x24, 0x24, 0x24, 0x18,  // 'o'
+    0xfc, 0x24, 0x24, 0x24, 0x18,  // 'p'
+    0x18, 0x24, 0x24, 0x24, 0x28, 0xfc,  // 'q'
+    0x3c, 0x08, 0x04, 0x04, 0x08,  // 'r'
+    0x28, 0x2c, 0x34, 0x34, 0x14,  // 's'
+    0x04, 0x1e, 0x24, 0x20, 0x10,  // 't'
+    0x1c, 0x20, 0x20, 0x20, 0x3c,  // 'u'
+    0x0c, 0x10, 0x20, 0x10, 0x0c,  // 'v'
+    0x3c, 0x10, 0x08, 0x10, 0x3c,  // 'w'
+    0x24, 0x18, 0x18, 0x24,  // 'x'
+    0x1c, 0xa0, 0xa0, 0xa0, 0x7c,  // 'y'
+    0x24, 0x34, 0x2c, 0x24, 0x24,  // 'z'
+    0x08, 0x36, 0x41,  // '{'
+    0xff,  // '|'
+    0x41, 0x36, 0x08,  // '}'
+    0x08, 0x04, 0x08, 0x10, 0x08,  // '~'
+    0x00, 0x00,  // 0xA0
+    0x7d,  // 0xA1
+    0x18, 0x24, 0x7e, 0x24, 0x24,  // 0xA2
+    0x48, 0x7e, 0x49, 0x41, 0x42,  // 0xA3
+    0x22, 0x1c, 0x14, 0x1c, 0x22,  // 0xA4
+    0x29, 0x2a, 0x7c, 0x2a, 0x29,  // 0xA5
+    0x77,  // 0xA6
+    0x4a, 0x55, 0x55, 0x29,  // 0xA7
+    0x01, 0x00, 0x01,  // 0xA8
+    0x3e, 0x41, 0x49, 0x55, 0x55, 0x41, 0x3e,  // 0xA9
+    0x12, 0x15, 0x17,  // 0xAA
+    0x08, 0x14, 0x22, 0x08, 0x14, 0x22,  // 0xAB
+    0x08, 0x08, 0x08, 0x08, 0x18,  // 0xAC
+    0x08, 0x08, 0x08, 0x08,  // 0xAD
+    0x3e, 0x41, 0x7d, 0x55, 0x69, 0x41, 0x3e,  // 0xAE
+    0x01, 0x01, 0x01, 0x01, 0x01,  // 0xAF
+    0x02, 0x05, 0x02,  // 0xB0
+    0x44, 0x44, 0x5f, 0x44, 0x44,  // 0xB1
+    0x09, 0x0d, 0x0a,  // 0xB2
+    0x09, 0x0b, 0x0f,  // 0xB3
+    0x02, 0x01,  // 0xB4
+    0xfc, 0x20, 0x20, 0x1c,  // 0xB5
+    0x06, 0x0f, 0x7f, 0x01, 0x7f,  // 0xB6
+    0x08,  // 0xB7
+    0x80, 0x40,  // 0xB8
+    0x0a, 0x0f, 0x08,  // 0xB9
+    0x12, 0x15, 0x12,  // 0xBA
+    0x22, 0x14, 0x08, 0x22, 0x14, 0x08,  // 0xBB
+    0x27, 0x10, 0x0c, 0x32, 0x79, 0x20,  // 0xBC
+    0x27, 0x10, 0x0c, 0x02, 0x69, 0x58, 0x40,  // 0xBD
+    0x25, 0x17, 0x08, 0x36, 0x79, 0x20,  // 0xBE
+    0x30, 0x48, 0x45, 0x40, 0x20,  // 0xBF
+    0xf0, 0x28, 0x25, 0x22, 0x24, 0x28, 0xf0,  // 0xC0
+    0xf0, 0x28, 0x24, 0x22, 0x25, 0x28, 0xf0,  // 0xC1
+    0xf0, 0x28, 0x25, 0x23, 0x25, 0x28, 0xf0,  // 0xC2
+    0xf0, 0x29, 0x25, 0x22, 0x25, 0x29, 0xf0,  // 0xC3
+    0xf0, 0x28, 0x25, 0x22, 0x25, 0x28, 0xf0,  // 0xC4
+    0xf0, 0x28, 0x24, 0x23, 0x24, 0x28, 0xf0,  // 0xC5
+    0x7e, 0x09, 0x7f, 0x49, 0x49, 0x49,  // 0xC6
+    0x7e, 0x41, 0x41, 0xc1, 0x41, 0x41, 0x41,  // 0xC7
+    0xfe, 0x92, 0x93, 0x92, 0x92, 0x92, 0x92,  // 0xC8
+    0xfe, 0x92, 0x92, 0x92, 0x93, 0x92, 0x92,  // 0xC9
+    0xfe, 0x92, 0x93, 0x93, 0x93, 0x92, 0x92,  // 0xCA
+    0xfe, 0x92, 0x93, 0x92, 0x93, 0x92, 0x92,  // 0xCB
+    0x01, 0xfe,  // 0xCC
+    0xfe, 0x01,  // 0xCD
+    0x01, 0xff, 0x01,  // 0xCE
+    0x01, 0xfe, 0x01,  // 0xCF
+    0x49, 0x7f, 0x49, 0x41, 0x3e,  // 0xD0
+    0xfe, 0x05, 0x09, 0x10, 0x21, 0x41, 0xfe,  // 0xD1
+    0x7c, 0x82, 0x83, 0x82, 0x82, 0x82, 0x7c,  // 0xD2
+    0x7c, 0x82, 0x82, 0x82, 0x83, 0x82, 0x7c,  // 0xD3
+    0x7c, 0x82, 0x83, 0x83, 0x83, 0x82, 0x7c,  // 0xD4
+    0x7c, 0x83, 0x83, 0x82, 0x83, 0x83, 0x7c,  // 0xD5
+    0x7c, 0x82, 0x83, 0x82, 0x83, 0x82, 0x7c,  // 0xD6
+    0x22, 0x14, 0x08, 0x14, 0x22,  // 0xD7
+    0x7e, 0x61, 0x5d, 0x43, 0x3f,  // 0xD8
+    0x7e, 0x80, 0x81, 0x80, 0x80, 0x80, 0x7e,  // 0xD9
+    0x7e, 0x80, 0x80, 0x80, 0x81, 0x80, 0x7e,  // 0xDA
+    0x7e, 0x80, 0x81, 0x81, 0x81, 0x80, 0x7e,  // 0xDB
+    0x7e, 0x80, 0x81, 0x80, 0x81, 0x80, 0x7e,  // 0xDC
+    0x02, 0x04, 0x08, 0xf0, 0x09, 0x04, 0x02,  // 0xDD
+    0x7f, 0x12, 0x12, 0x12, 0x0c,  // 0xDE
+    0x7e, 0x01, 0x49, 0x36,  // 0xDF
+    0x18, 0x25, 0x26, 0x24, 0x3c,  // 0xE0
+    0x18, 0x24, 0x26, 0x25, 0x3c,  // 0xE1
+    0x18, 0x26, 0x25, 0x26, 0x3c,  // 0xE2
+    0x1a, 0x25, 0x25, 0x26, 0x3d,  // 0xE3
+    0x18, 0x26, 0x24, 0x26, 0x3c,  // 0xE4
+    0x18, 0x27, 0x25, 0x27, 0x3c,  // 0xE5
+    0x10, 0x2a, 0x2a, 0x1c, 0x2a, 0x2a, 0x2c,  // 0xE6
+    0x1c, 0xa2, 0x62, 0x22, 0x22,  // 0xE7
+    0x38, 0x44, 0x5d, 0x56, 0x54, 0x38,  // 0xE8
+    0x38, 0x44, 0x5c, 0x56, 0x55, 0x38,  // 0xE9
+    0x38, 0x44, 0x5e, 0x55, 0x56, 0x38,  // 0xEA
+    0x38, 0x44, 0x5e, 0x54, 0x56, 0x38,  // 0xEB
+    0x25, 0x3e, 0x20,  // 0xEC
+    0x24, 0x3e, 0x21,  // 0xED
+    0x26, 0x3d, 0x22,  // 0xEE
+    0x26, 0x3c, 0x22,  // 0xEF
+    0x18, 0x25, 0x27, 0x1e,  // 0xF0
+    0x3e, 0x09, 0x05, 0x06, 0x3d,  // 0xF1
+    0x18, 0x24, 0x25, 0x26, 0x24, 0x18,  // 0xF2
+    0x18, 0x24, 0x24, 0x26, 0x25, 0x18,  // 0xF3
+    0x18, 0x24, 0x26, 0x25, 0x26, 0x18,  // 0xF4
+    0x18, 0x26, 0x25, 0x25, 0x26, 0x19,  // 0xF5
+    0x18, 0x24, 0x26, 0x24, 0x26, 0x18,  // 0xF6
+    0x08, 0x08, 0x2a, 0x08, 0x08,  // 0xF7
+    0x1c, 0x32, 0x2a, 0x26, 0x1c,  // 0xF8
+    0x1c, 0x21, 0x22, 0x20, 0x3c,  // 0xF9
+    0x1c, 0x20, 0x22, 0x21, 0x3c,  // 0xFA
+    0x1c, 0x22, 0x21, 0x22, 0x3c,  // 0xFB
+    0x1c, 0x22, 0x20, 0x22, 0x3c,  // 0xFC
+    0x1c, 0xa0, 0xa2, 0xa1, 0x7c,  // 0xFD
+    0xfe, 0x24, 0x24, 0x18,  // 0xFE
+    0x1c, 0xa2, 0xa0, 0xa2, 0x7c,  // 0xFF
+};
+
+// Indexada pelo codigo Latin-1 do caractere; codigos sem desenho usam '?'
+static const fonte_glifo_t fonte_glifos[256] = {
+  {  131, 5 },  // 0x00
+  {  131, 5 },  // 0x01
+  {  131, 5 },  // 0x02
+  {  131, 5 },  // 0x03
+  {  131, 5 },  // 0x04
+  {  131, 5 },  // 0x05
+  {  131, 5 },  // 0x06
+  {  131, 5 },  // 0x07
+  {  131, 5 },  // 0x08
+  {  131, 5 },  // 0x09
+  {  131, 5 },  // 0x0A
+  {  131, 5 },  // 0x0B
+  {  131, 5 },  // 0x0C
+  {  131, 5 },  // 0x0D
+  {  131, 5 },  // 0x0E
+  {  131, 5 },  // 0x0F
+  {  131, 5 },  // 0x10
+  {  131, 5 },  // 0x11
+  {  131, 5 },  // 0x12
+  {  131, 5 },  // 0x13
+  {  131, 5 },  // 0x14
+  {  131, 5 },  // 0x15
+  {  131, 5 },  // 0x16
+  {  131, 5 },  // 0x17
+  {  131, 5 },  // 0x18
+  {  131, 5 },  // 0x19
+  {  131, 5 },  // 0x1A
+  {  131, 5 },  // 0x1B
+  {  131, 5 },  // 0x1C
+  {  131, 5 },  // 0x1D
+  {  131, 5 },  // 0x1E
+  {  131, 5 },  // 0x1F
+  {    0, 2 },  // ' '
+  {    2, 1 },  // '!'
+  {    3, 3 },  // '"'
+  {    6, 5 },  // '#'
+  {   11, 5 },  // '$'
+  {   16, 5 },  // '%'
+  {   21, 5 },  // '&'
+  {   26, 1 },  // '''
+  {   27, 2 },  // '('
+  {   29, 2 },  // ')'
+  {   31, 5 },  // '*'
+  {   36, 5 },  // '+'
+  {   41, 2 },  // ','
+  {   43, 4 },  // '-'
+  {   47, 1 },  // '.'
+  {   48, 5 },  // '/'
+  {   53, 7 },  // '0'
+  {   60, 3 },  // '1'
+  {   63, 6 },  // '2'
+  {   69, 7 },  // '3'
+  {   76, 6 },  // '4'
+  {   82, 6 },  // '5'
+  {   88, 7 },  // '6'
+  {   95, 7 },  // '7'
+  {  102, 7 },  // '8'
+  {  109, 7 },  // '9'
+  {  116, 1 },  // ':'
+  {  117, 2 },  // ';'
+  {  119, 4 },  // '<'
+  {  123, 4 },  // '='
+  {  127, 4 },  // '>'
+  {  131, 5 },  // '?'
+  {  136, 5 },  // '@'
+  {  141, 7 },  // 'A'
+  {  148, 7 },  // 'B'
+  {  155, 7 },  // 'C'
+  {  162, 7 },  // 'D'
+  {  169, 7 },  // 'E'
+  {  176, 7 },  // 'F'
+  {  183, 7 },  // 'G'
+  {  190, 7 },  // 'H'
+  {  197, 1 },  // 'I'
+  {  198, 7 },  // 'J'
+  {  205, 6 },  // 'K'
+  {  211, 7 },  // 'L'
+  {  218, 7 },  // 'M'
+  {  225, 7 },  // 'N'
+  {  232, 7 },  // 'O'
+  {  239, 7 },  // 'P'
+  {  246, 7 },  // 'Q'
+  {  253, 7 },  // 'R'
+  {  260, 6 },  // 'S'
+  {  266, 7 },  // 'T'
+  {  273, 7 },  // 'U'
+  {  280, 7 },  // 'V'
+  {  287, 7 },  // 'W'
+  {  294, 6 },  // 'X'
+  {  300, 7 },  // 'Y'
+  {  307, 6 },  // 'Z'
+  {  313, 2 },  // '['
+  {  315, 5 },  // '\\'
+  {  320, 2 },  // ']'
+  {  322, 5 },  // '^'
+  {  327, 5 },  // '_'
+  {  332, 2 },  // '`'
+  {  334, 5 },  // 'a'
+  {  339, 6 },  // 'b'
+  {  345, 5 },  // 'c'
+  {  350, 6 },  // 'd'
+  {  356, 6 },  // 'e'
+  {  362, 5 },  // 'f'
+  {  367, 6 },  // 'g'
+  {  373, 6 },  // 'h'
+  {  379, 3 },  // 'i'
+  {  382, 4 },  // 'j'
+  {  386, 5 },  // 'k'
+  {  391, 3 },  // 'l'
+  {  394, 5 },  // 'm'
+  {  399, 5 },  // 'n'
+  {  404, 6 },  // 'o'
+  {  410, 5 },  // 'p'
+  {  415, 6 },  // 'q'
+  {  421, 5 },  // 'r'
+  {  426, 5 },  // 's'
+  {  431, 5 },  // 't'
+  {  436, 5 },  // 'u'
+  {  441, 5 },  // 'v'
+  {  446, 5 },  // 'w'
+  {  451, 4 },  // 'x'
+  {  455, 5 },  // 'y'
+  {  460, 5 },  // 'z'
+  {  465, 3 },  // '{'
+  {  468, 1 },  // '|'
+  {  469, 3 },  // '}'
+  {  472, 5 },  // '~'
+  {  131, 5 },  // 0x7F
+  {  131, 5 },  // 0x80
+  {  131, 5 },  // 0x81
+  {  131, 5 },  // 0x82
+  {  131, 5 },  // 0x83
+  {  131, 5 },  // 0x84
+  {  131, 5 },  // 0x85
+  {  131, 5 },  // 0x86
+  {  131, 5 },  // 0x87
+  {  131, 5 },  // 0x88
+  {  131, 5 },  // 0x89
+  {  131, 5 },  // 0x8A
+  {  131, 5 },  // 0x8B
+  {  131, 5 },  // 0x8C
+  {  131, 5 },  // 0x8D
+  {  131, 5 },  // 0x8E
+  {  131, 5 },  // 0x8F
+  {  131, 5 },  // 0x90
+  {  131, 5 },  // 0x91
+  {  131, 5 },  // 0x92
+  {  131, 5 },  // 0x93
+  {  131, 5 },  // 0x94
+  {  131, 5 },  // 0x95
+  {  131, 5 },  // 0x96
+  {  131, 5 },  // 0x97
+  {  131, 5 },  // 0x98
+  {  131, 5 },  // 0x99
+  {  131, 5 },  // 0x9A
+  {  131, 5 },  // 0x9B
+  {  131, 5 },  // 0x9C
+  {  131, 5 },  // 0x9D
+  {  131, 5 },  // 0x9E
+  {  131, 5 },  // 0x9F
+  {  477, 2 },  // 0xA0
+  {  479, 1 },  // 0xA1
+  {  480, 5 },  // 0xA2
+  {  485, 5 },  // 0xA3
+  {  490, 5 },  // 0xA4
+  {  495, 5 },  // 0xA5
+  {  500, 1 },  // 0xA6
+  {  501, 4 },  // 0xA7
+  {  505, 3 },  // 0xA8
+  {  508, 7 },  // 0xA9
+  {  515, 3 },  // 0xAA
+  {  518, 6 },  // 0xAB
+  {  524, 5 },  // 0xAC
+  {  529, 4 },  // 0xAD
+  {  533, 7 },  // 0xAE
+  {  540, 5 },  // 0xAF
+  {  545, 3 },  // 0xB0
+  {  548, 5 },  // 0xB1
+  {  553, 3 },  // 0xB2
+  {  556, 3 },  // 0xB3
+  {  559, 2 },  // 0xB4
+  {  561, 4 },  // 0xB5
+  {  565, 5 },  // 0xB6
+  {  570, 1 },  // 0xB7
+  {  571, 2 },  // 0xB8
+  {  573, 3 },  // 0xB9
+  {  576, 3 },  // 0xBA
+  {  579, 6 },  // 0xBB
+  {  585, 6 },  // 0xBC
+  {  591, 7 },  // 0xBD
+  {  598, 6 },  // 0xBE
+  {  604, 5 },  // 0xBF
+  {  609, 7 },  // 0xC0
+  {  616, 7 },  // 0xC1
+  {  623, 7 },  // 0xC2
+  {  630, 7 },  // 0xC3
+  {  637, 7 },  // 0xC4
+  {  644, 7 },  // 0xC5
+  {  651, 6 },  // 0xC6
+  {  657, 7 },  // 0xC7
+  {  664, 7 },  // 0xC8
+  {  671, 7 },  // 0xC9
+  {  678, 7 },  // 0xCA
+  {  685, 7 },  // 0xCB
+  {  692, 2 },  // 0xCC
+  {  694, 2 },  // 0xCD
+  {  696, 3 },  // 0xCE
+  {  699, 3 },  // 0xCF
+  {  702, 5 },  // 0xD0
+  {  707, 7 },  // 0xD1
+  {  714, 7 },  // 0xD2
+  {  721, 7 },  // 0xD3
+  {  728, 7 },  // 0xD4
+  {  735, 7 },  // 0xD5
+  {  742, 7 },  // 0xD6
+  {  749, 5 },  // 0xD7
+  {  754, 5 },  // 0xD8
+  {  759, 7 },  // 0xD9
+  {  766, 7 },  // 0xDA
+  {  773, 7 },  // 0xDB
+  {  780, 7 },  // 0xDC
+  {  787, 7 },  // 0xDD
+  {  794, 5 },  // 0xDE
+  {  799, 4 },  // 0xDF
+  {  803, 5 },  // 0xE0
+  {  808, 5 },  // 0xE1
+  {  813, 5 },  // 0xE2
+  {  818, 5 },  // 0xE3
+  {  823, 5 },  // 0xE4
+  {  828, 5 },  // 0xE5
+  {  833, 7 },  // 0xE6
+  {  840, 5 },  // 0xE7
+  {  845, 6 },  // 0xE8
+  {  851, 6 },  // 0xE9
+  {  857, 6 },  // 0xEA
+  {  863, 6 },  // 0xEB
+  {  869, 3 },  // 0xEC
+  {  872, 3 },  // 0xED
+  {  875, 3 },  // 0xEE
+  {  878, 3 },  // 0xEF
+  {  881, 4 },  // 0xF0
+  {  885, 5 },  // 0xF1
+  {  890, 6 },  // 0xF2
+  {  896, 6 },  // 0xF3
+  {  902, 6 },  // 0xF4
+  {  908, 6 },  // 0xF5
+  {  914, 6 },  // 0xF6
+  {  920, 5 },  // 0xF7
+  {  925, 5 },  // 0xF8
+  {  930, 5 },  // 0xF9
+  {  935, 5 },  // 0xFA
+  {  940, 5 },  // 0xFB
+  {  945, 5 },  // 0xFC
+  {  950, 5 },  // 0xFD
+  {  955, 4 },  // 0xFE
+  {  959, 5 },  // 0xFF
 };
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef FRAMEBUFFER_HPP
+#define FRAMEBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "ssd1306.h"
+
+// Buffer do SSD1306 com a geometria fixada em tempo de compilação. Largura,
+// altura e modo de endereçamento são parâmetros do template: os índices,
+// passos e limites são constantes e os laços das primitivas têm passo fixo.
+// Trabalha sobre o ram_buffer e as regiões alteradas de um ssd1306_t, então
+// o envio continua a cargo de ssd1306_send_data.
+
+// Modos de endereçamento da memória do display (comando SET_MEM_ADDR)
+enum class Enderecamento : uint8_t {
+  Horizontal = SSD1306_HORIZONTAL,
+  Vertical = SSD1306_VERTICAL,
+};
+
+template <uint8_t Largura, uint8_t Altura, Enderecamento Modo>
+class Framebuffer {
+public:
+  static_assert(Largura > 0, "largura vazia");
+  static_assert(Altura % 8 == 0 && Altura / 8 <= SSD1306_MAX_PAGES, "altura deve ser de 8 a 64, em páginas inteiras");
+
+  static constexpr uint8_t largura = Largura;
+  static constexpr uint8_t altura = Altura;
+  static constexpr uint8_t paginas = Altura / 8;
+  static constexpr size_t tamanho = size_t(Largura) * paginas;
+
+  // Distância em bytes entre colunas vizinhas e entre páginas vizinhas
+  static constexpr size_t passo_coluna = Modo == Enderecamento::Vertical ? paginas : 1;
+  static constexpr size_t passo_pagina = Modo == Enderecamento::Vertical ? 1 : Largura;
+
+  static constexpr size_t indice(uint8_t x, uint8_t pagina) {
+    return x * passo_coluna + pagina * passo_pagina;
+  }
+
+  static constexpr bool dentro(uint8_t x, uint8_t y) {
+    return x < Largura && y < Altura;
+  }
+
+  // Máscara das linhas y0..y1 (inclusive) de uma coluna, um bit por linha
+  static constexpr uint64_t mascara_linhas(uint8_t y0, uint8_t y1) {
+    return (~0ULL >> (63 - (y1 - y0))) << y0;
+  }
+
+  static constexpr bool compativel(uint8_t largura, uint8_t altura) {
+    return largura == Largura && altura == Altura;
+  }
+
+  static bool compativel(const ssd1306_t *ssd) {
+    return compativel(ssd->width, ssd->height) && ssd->addressing == uint8_t(Modo);
+  }
+
+  explicit Framebuffer(ssd1306_t *ssd) : ssd_(ssd), dados_(ssd->ram_buffer + 1) {}
+
+  void pixel(uint8_t x, uint8_t y, bool valor) {
+    if (!dentro(x, y))
+      return;
+    uint8_t &byte = dados_[indice(x, y >> 3)];
+    uint8_t bit = 1u << (y & 7);
+    byte = valor ? (byte | bit) : (byte & ~bit);
+    marcar(x, x, y >> 3, y >> 3);
+  }
+
+  void preencher(bool valor) {
+    memset(dados_, valor ? 0xFF : 0x00, tamanho);
+    marcar(0, Largura - 1, 0, paginas - 1);
+  }
+
+  // Cada coluna do retângulo recebe uma única máscara: as laterais cobrem
+  // toda a altura, as demais só o topo e a base (ou o interior, se "cheio").
+  void retangulo(uint8_t topo, uint8_t esquerda, uint8_t w, uint8_t h, bool valor, bool cheio) {
+    if (w == 0 || h == 0 || !dentro(esquerda, topo))
+      return;
+
+    uint16_t direita = esquerda + w - 1;
+    uint16_t base = topo + h - 1;
+    uint8_t ultima_linha = base < Altura ? base : Altura - 1;
+    uint8_t ultima_coluna = direita < Largura ? direita : Largura - 1;
+
+    uint64_t lateral = mascara_linhas(topo, ultima_linha);
+    uint64_t meio = 1ULL << topo;
+    if (base < Altura)
+      meio |= 1ULL << base;
+    int fim_interior = ultima_linha == base ? base - 1 : ultima_linha;
+    if (cheio && topo + 1 <= fim_interior)
+      meio |= mascara_linhas(topo + 1, fim_interior);
+
+    for (uint16_t x = esquerda; x <= ultima_coluna; ++x)
+      aplicar_coluna(x, (x == esquerda || x == direita) ? lateral : meio, valor);
+  }
+
+  // Copia colunas de 8 linhas (bit 0 em cima, o formato da fonte). Com y
+  // múltiplo de 8 cada coluna é um único byte; senão ela se divide em duas
+  // páginas, com deslocamento e máscara.
+  void bitmap(const uint8_t *colunas, uint8_t w, uint8_t x, uint8_t y) {
+    if (!dentro(x, y) || w == 0)
+      return;
+    if (x + w > Largura)
+      w = Largura - x;
+
+    uint8_t pagina = y >> 3;
+    uint8_t deslocamento = y & 7;
+    uint8_t *destino = dados_ + indice(x, pagina);
+
+    if (deslocamento == 0) {
+      for (uint8_t i = 0; i < w; ++i, destino += passo_coluna)
+        *destino = colunas[i];
+      marcar(x, x + w - 1, pagina, pagina);
+      return;
+    }
+
+    bool tem_segunda = pagina + 1 < paginas;
+    uint8_t mascara_baixa = 0xFF << deslocamento;
+    uint8_t mascara_alta = 0xFF >> (8 - deslocamento);
+
+    for (uint8_t i = 0; i < w; ++i, destino += passo_coluna) {
+      destino[0] = (destino[0] & ~mascara_baixa) | uint8_t(colunas[i] << deslocamento);
+      if (tem_segunda)
+        destino[passo_pagina] = (destino[passo_pagina] & ~mascara_alta) | (colunas[i] >> (8 - deslocamento));
+    }
+    marcar(x, x + w - 1, pagina, tem_segunda ? pagina + 1 : pagina);
+  }
+
+  // Desloca uma região uma coluna para a esquerda; a última coluna fica como
+  // estava. As páginas inteiras são movidas byte a byte e as parciais trocam
+  // só as linhas da região. No modo vertical com a altura toda as colunas
+  // são contíguas e basta um memmove; no horizontal cada página é contígua.
+  void rolar_esquerda(uint8_t topo, uint8_t esquerda, uint8_t w, uint8_t h) {
+    if (w < 2 || h == 0 || !dentro(esquerda, topo))
+      return;
+
+    uint16_t direita = esquerda + w - 1;
+    uint16_t base = topo + h - 1;
+    if (direita >= Largura)
+      direita = Largura - 1;
+    if (base >= Altura)
+      base = Altura - 1;
+    if (direita == esquerda)
+      return;
+
+    uint8_t p0 = topo >> 3, p1 = base >> 3;
+    uint64_t mascara = mascara_linhas(topo, base);
+
+    if (Modo == Enderecamento::Vertical && p0 == 0 && p1 == paginas - 1 && (topo & 7) == 0 && (base & 7) == 7) {
+      uint8_t *inicio = dados_ + indice(esquerda, 0);
+      memmove(inicio, inicio + passo_coluna, (direita - esquerda) * passo_coluna);
+    } else {
+      for (uint8_t p = p0; p <= p1; ++p) {
+        uint8_t m = uint8_t(mascara >> (p * 8));
+        uint8_t *destino = dados_ + indice(esquerda, p);
+        if (Modo == Enderecamento::Horizontal && m == 0xFF) {
+          memmove(destino, destino + 1, direita - esquerda);
+          continue;
+        }
+        for (uint16_t x = esquerda; x < direita; ++x, destino += passo_coluna)
+          destino[0] = (destino[0] & ~m) | (destino[passo_coluna] & m);
+      }
+    }
+    marcar(esquerda, direita - 1, p0, p1);
+  }
+
+private:
+  ssd1306_t *ssd_;
+  uint8_t *dados_;
+
+  void marcar(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+    ssd1306_marcar_alterado(ssd_, x0, x1, p0, p1);
+  }
+
+  // Aplica uma máscara de linhas a uma coluna. No modo vertical com um
+  // múltiplo de 4 páginas a coluna são palavras de 32 bits alinhadas (o
+  // ram_buffer começa alinhado); nos demais casos, um byte por página.
+  // Uma máscara vazia não altera nada (e não teria página para marcar).
+  void aplicar_coluna(uint8_t x, uint64_t mascara, bool valor) {
+    if (mascara == 0)
+      return;
+
+    uint8_t p0 = 0, p1 = paginas - 1;
+    while (!((mascara >> (p0 * 8)) & 0xFF))
+      ++p0;
+    while (!((mascara >> (p1 * 8)) & 0xFF))
+      --p1;
+    marcar(x, x, p0, p1);
+
+    uint8_t *coluna = dados_ + indice(x, 0);
+    if constexpr (Modo == Enderecamento::Vertical && paginas % 4 == 0) {
+      uint8_t *alinhada = static_cast<uint8_t *>(__builtin_assume_aligned(coluna, 4));
+      for (uint8_t i = 0; i < paginas / 4; ++i, mascara >>= 32) {
+        uint32_t m = uint32_t(mascara);
+        if (!m)
+          continue;
+        uint32_t palavra;
+        memcpy(&palavra, alinhada + 4 * i, 4);
+        palavra = valor ? (palavra | m) : (palavra & ~m);
+        memcpy(alinhada + 4 * i, &palavra, 4);
+      }
+    } else {
+      for (uint8_t i = 0; i < paginas; ++i, mascara >>= 8) {
+        uint8_t m = uint8_t(mascara);
+        if (m)
+          coluna[i * passo_pagina] = valor ? (coluna[i * passo_pagina] | m) : (coluna[i * passo_pagina] & ~m);
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,69 @@
+// Arquivo gerado por tools/gerar_gamma_lut.py - nao editar manualmente.
+// Gama 2.2 para os canais da matriz e escala Q16 dos niveis de brilho.
+
+#ifndef GAMMA_LUT_H
+#define GAMMA_LUT_H
+
+#include <stdint.h>
+
+static const uint16_t gamma16_lut[256] = {
+    0, 0, 2, 4, 7, 11, 17, 24, 32, 42, 53, 65,
+    78, 94, 110, 128, 148, 169, 191, 216, 241, 269, 298, 328,
+    360, 394, 430, 467, 506, 547, 589, 633, 679, 726, 776, 827,
+    880, 934, 991, 1049, 1109, 1171, 1235, 1300, 1368, 1437, 1508, 1581,
+    1656, 1733, 1812, 1893, 1975, 2060, 2146, 2235, 2325, 2417, 2512, 2608,
+    2706, 2806, 2908, 3013, 3119, 3227, 3337, 3450, 3564, 3680, 3798, 3919,
+    4041, 4166, 4292, 4421, 4552, 4685, 4819, 4956, 5096, 5237, 5380, 5525,
+    5673, 5823, 5974, 6128, 6284, 6442, 6603, 6765, 6930, 7097, 7266, 7437,
+    7610, 7786, 7963, 8143, 8325, 8509, 8696, 8885, 9075, 9268, 9464, 9661,
+    9861, 10063, 10267, 10474, 10682, 10893, 11107, 11322, 11540, 11760, 11982, 12207,
+    12433, 12663, 12894, 13128, 13363, 13602, 13842, 14085, 14330, 14578, 14827, 15080,
+    15334, 15591, 15850, 16111, 16375, 16641, 16909, 17180, 17453, 17729, 18006, 18287,
+    18569, 18854, 19141, 19431, 19723, 20017, 20314, 20613, 20915, 21218, 21525, 21833,
+    22144, 22458, 22774, 23092, 23413, 23736, 24062, 24390, 24720, 25053, 25388, 25726,
+    26066, 26408, 26753, 27101, 27451, 27803, 28158, 28515, 28875, 29237, 29602, 29969,
+    30338, 30710, 31085, 31462, 31841, 32223, 32608, 32995, 33384, 33776, 34170, 34567,
+    34967, 35369, 35773, 36180, 36589, 37001, 37416, 37833, 38252, 38674, 39099, 39526,
+    39956, 40388, 40823, 41260, 41700, 42142, 42587, 43034, 43484, 43937, 44392, 44849,
+    45310, 45772, 46238, 46706, 47176, 47649, 48125, 48603, 49084, 49567, 50053, 50542,
+    51033, 51526, 52023, 52522, 53023, 53527, 54034, 54543, 55055, 55570, 56087, 56607,
+    57129, 57654, 58182, 58712, 59245, 59780, 60318, 60859, 61402, 61948, 62497, 63048,
+    63602, 64159, 64718, 65280,
+};
+
+static const uint32_t escala_lut[256] = {
+    0, 257, 514, 771, 1028, 1285, 1542, 1799,
+    2056, 2313, 2570, 2827, 3084, 3341, 3598, 3855,
+    4112, 4369, 4626, 4883, 5140, 5397, 5654, 5911,
+    6168, 6425, 6682, 6939, 7196, 7453, 7710, 7967,
+    8224, 8481, 8738, 8995, 9252, 9509, 9766, 10023,
+    10280, 10537, 10794, 11051, 11308, 11565, 11822, 12079,
+    12336, 12593, 12850, 13107, 13364, 13621, 13878, 14135,
+    14392, 14649, 14906, 15163, 15420, 15677, 15934, 16191,
+    16448, 16705, 16962, 17219, 17476, 17733, 17990, 18247,
+    18504, 18761, 19018, 19275, 19532, 19789, 20046, 20303,
+    20560, 20817, 21074, 21331, 21588, 21845, 22102, 22359,
+    22616, 22873, 23130, 23387, 23644, 23901, 24158, 24415,
+    24672, 24929, 25186, 25443, 25700, 25957, 26214, 26471,
+    26728, 26985, 27242, 27499, 27756, 28013, 28270, 28527,
+    28784, 29041, 29298, 29555, 29812, 30069, 30326, 30583,
+    30840, 31097, 31354, 31611, 31868, 32125, 32382, 32639,
+    32897, 33154, 33411, 33668, 33925, 34182, 34439, 34696,
+    34953, 35210, 35467, 35724, 35981, 36238, 36495, 36752,
+    37009, 37266, 37523, 37780, 38037, 38294, 38551, 38808,
+    39065, 39322, 39579, 39836, 40093, 40350, 40607, 40864,
+    41121, 41378, 41635, 41892, 42149, 42406, 42663, 42920,
+    43177, 43434, 43691, 43948, 44205, 44462, 44719, 44976,
+    45233, 45490, 45747, 46004, 46261, 46518, 46775, 47032,
+    47289, 47546, 47803, 48060, 48317, 48574, 48831, 49088,
+    49345, 49602, 49859, 50116, 50373, 50630, 50887, 51144,
+    51401, 51658, 51915, 52172, 52429, 52686, 52943, 53200,
+    53457, 53714, 53971, 54228, 54485, 54742, 54999, 55256,
+    55513, 55770, 56027, 56284, 56541, 56798, 57055, 57312,
+    57569, 57826, 58083, 58340, 58597, 58854, 59111, 59368,
+    59625, 59882, 60139, 60396, 60653, 60910, 61167, 61424,
+    61681, 61938, 62195, 62452, 62709, 62966, 63223, 63480,
+    63737, 63994, 64251, 64508, 64765, 65022, 65279, 65536,
+};
+
+#endif
@@ -0,0 +1,505 @@
+#include <stdio.h>
+#include <string.h>
+#include "historico.h"
+
+// Acumulador de um intervalo ainda em formação
+typedef struct {
+    int16_t min, max;
+    int32_t soma;
+    uint16_t n;
+} hist_acum_t;
+
+// Bloco comprimido. O primeiro ponto guarda os valores, o segundo a diferença
+// para o primeiro e os demais a diferença entre diferenças consecutivas, todos
+// em zigzag + varint. Cada bloco pode ser decodificado isoladamente.
+//
+// A partir do terceiro ponto, pontos seguidos com delta-de-delta zero em todos
+// os campos formam corridas. O primeiro varint de cada ponto diz o que vem:
+// de 1 a 15 é uma corrida curta com essa contagem; 0 é uma corrida longa,
+// com a contagem no byte seguinte, usada depois de uma curta cheia; a partir
+// de HIST_LITERAL é um ponto literal, com o primeiro campo somado de
+// HIST_LITERAL. A contagem cresce no próprio byte enquanto a corrida dura.
+#define HIST_CORRIDA_CURTA  15
+#define HIST_CORRIDA_LONGA  255
+#define HIST_LITERAL        16
+
+typedef struct {
+    uint8_t dados[HIST_BLOCO_BYTES];
+    uint8_t usado;                // Bytes ocupados
+    volatile uint16_t pontos;     // Pontos completos no bloco
+    volatile uint32_t primeiro;   // Número absoluto do primeiro ponto
+} hist_bloco_t;
+
+// Anel de blocos de uma resolução. "total" nunca volta a zero.
+typedef struct {
+    hist_bloco_t *blocos;
+    uint8_t num_blocos;
+    uint8_t campos;
+    uint8_t atual;                // Bloco em escrita
+    uint8_t ocupados;             // Blocos com dados
+    uint8_t corrida;              // Pontos da corrida no fim do bloco atual (0 = último ponto literal)
+    uint8_t limite_corrida;       // HIST_CORRIDA_CURTA ou HIST_CORRIDA_LONGA
+    volatile uint32_t total;
+    int16_t valor[HIST_MAX_CAMPOS];   // Estado do codificador no bloco atual
+    int32_t delta[HIST_MAX_CAMPOS];
+} hist_anel_t;
+
+// Dados de uma série: anéis das três resoluções e acumuladores dos resumos
+typedef struct {
+    hist_bloco_t b1s[HIST_BLOCOS_1S];
+    hist_bloco_t b1min[HIST_BLOCOS_1MIN];
+    hist_bloco_t b15min[HIST_BLOCOS_15MIN];
+    hist_anel_t aneis[HIST_NUM_RES];
+    hist_acum_t acum_1min, acum_15min;
+} hist_dados_t;
+
+// Cerca de 1,2 KB por série, alocados estaticamente
+static hist_dados_t dados[HIST_NUM_SERIES];
+static bool iniciado = false;
+
+// As séries dos cômodos levam o nome da API: luz_sala, luz_cozinha, ...
+#define HIST_X_NOME(id, nome, ...) "luz_" nome,
+#define HIST_X_UNIDADE(id, nome, ...) "pct_ligado",
+static const char *const nomes_serie[HIST_NUM_SERIES] = {
+    "temperatura", "distancia", "luz", "televisao", LAYOUT_COMODOS(HIST_X_NOME)
+};
+static const char *const unidades_serie[HIST_NUM_SERIES] = {
+    "centi_C", "mm", "nivel", "pct_ligado", LAYOUT_COMODOS(HIST_X_UNIDADE)
+};
+static const char *const nomes_res[HIST_NUM_RES] = { "1s", "1m", "15m" };
+static const uint16_t periodo_res_s[HIST_NUM_RES] = { 1, 60, 900 };
+
+// Etapas da exportação
+enum { ETAPA_CABECALHO, ETAPA_PONTOS, ETAPA_RODAPE, ETAPA_CONCLUIDA };
+
+/* ========== CODIFICAÇÃO ========== */
+
+static inline uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t dezigzag(uint32_t z) {
+    return (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+}
+
+// Escreve um varint e retorna o número de bytes usados (no máximo 5)
+static uint8_t varint_escrever(uint8_t *destino, uint32_t v) {
+    uint8_t n = 0;
+    while (v >= 0x80) {
+        destino[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    destino[n++] = (uint8_t)v;
+    return n;
+}
+
+// Lê um varint; retorna false se o bloco terminar antes do fim do número
+static bool varint_ler(const uint8_t *dados, uint8_t tamanho, uint8_t *pos, uint32_t *v) {
+    uint32_t resultado = 0;
+    for (uint8_t desloc = 0; *pos < tamanho && desloc < 35; desloc += 7) {
+        uint8_t byte = dados[(*pos)++];
+        resultado |= (uint32_t)(byte & 0x7F) << desloc;
+        if (!(byte & 0x80)) {
+            *v = resultado;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void anel_configurar(hist_anel_t *anel, hist_bloco_t *blocos, uint8_t num_blocos, uint8_t campos) {
+    memset(anel, 0, sizeof(*anel));
+    anel->blocos = blocos;
+    anel->num_blocos = num_blocos;
+    anel->campos = campos;
+}
+
+// Codifica um ponto segundo sua posição no bloco (valor, delta ou
+// delta-de-delta). "zeros" indica um ponto codificado como corrida de um.
+static uint8_t anel_codificar(const hist_anel_t *anel, uint16_t posicao, const int16_t *valores,
+                              uint8_t *destino, int32_t *novo_delta, bool *zeros) {
+    uint32_t z[HIST_MAX_CAMPOS] = { 0 };
+    bool todos_zero = posicao >= 2;
+    for (uint8_t c = 0; c < anel->campos; c++) {
+        int32_t v;
+        if (posicao == 0) {
+            novo_delta[c] = 0;
+            v = valores[c];
+        } else {
+            novo_delta[c] = (int32_t)valores[c] - anel->valor[c];
+            v = posicao == 1 ? novo_delta[c] : novo_delta[c] - anel->delta[c];
+        }
+        z[c] = zigzag(v);
+        todos_zero = todos_zero && v == 0;
+    }
+
+    *zeros = todos_zero;
+    if (todos_zero) {
+        destino[0] = 1;                   // Corrida curta de um ponto
+        return 1;
+    }
+    uint8_t n = 0;
+    for (uint8_t c = 0; c < anel->campos; c++) {
+        n += varint_escrever(destino + n, c == 0 && posicao >= 2 ? z[c] + HIST_LITERAL : z[c]);
+    }
+    return n;
+}
+
+// Começa um novo bloco, descartando o mais antigo se o anel estiver cheio
+static hist_bloco_t *anel_novo_bloco(hist_anel_t *anel) {
+    if (anel->ocupados > 0) {
+        anel->atual = (anel->atual + 1) % anel->num_blocos;
+    }
+    if (anel->ocupados < anel->num_blocos) {
+        anel->ocupados++;
+    }
+
+    hist_bloco_t *bloco = &anel->blocos[anel->atual];
+
+    // Invalida o bloco antes de reutilizá-lo, para que um leitor que
+    // interrompa a escrita não decodifique dados novos com o estado antigo
+    bloco->pontos = 0;
+    __dmb();
+    bloco->primeiro = anel->total;
+    bloco->usado = 0;
+    anel->corrida = 0;
+    return bloco;
+}
+
+// Acrescenta um ponto ao anel
+static void anel_adicionar(hist_anel_t *anel, const int16_t *valores) {
+    uint8_t codigo[HIST_MAX_CAMPOS * 5];
+    int32_t novo_delta[HIST_MAX_CAMPOS];
+    hist_bloco_t *bloco = &anel->blocos[anel->atual];
+    uint8_t n = 0;
+    bool zeros = false;
+
+    if (anel->ocupados > 0 && bloco->pontos < UINT16_MAX) {
+        n = anel_codificar(anel, bloco->pontos, valores, codigo, novo_delta, &zeros);
+    }
+
+    if (zeros && anel->corrida > 0 && anel->corrida < anel->limite_corrida) {
+        // Estende a corrida no fim do bloco sem gastar bytes. Um leitor só
+        // passa do byte da contagem quando já há um ponto depois dela.
+        bloco->dados[bloco->usado - 1]++;
+        anel->corrida++;
+    } else {
+        anel->limite_corrida = HIST_CORRIDA_CURTA;
+        if (zeros && anel->corrida > 0) {
+            // Corrida cheia: a seguinte é longa
+            codigo[0] = 0;
+            codigo[1] = 1;
+            n = 2;
+            anel->limite_corrida = HIST_CORRIDA_LONGA;
+        }
+        if (anel->ocupados == 0 || bloco->usado + n > HIST_BLOCO_BYTES || bloco->pontos == UINT16_MAX) {
+            bloco = anel_novo_bloco(anel);
+            n = anel_codificar(anel, 0, valores, codigo, novo_delta, &zeros);
+        }
+        memcpy(bloco->dados + bloco->usado, codigo, n);
+        bloco->usado += n;
+        anel->corrida = zeros ? 1 : 0;
+    }
+    for (uint8_t c = 0; c < anel->campos; c++) {
+        anel->valor[c] = valores[c];
+        anel->delta[c] = novo_delta[c];
+    }
+
+    // Só publica o ponto depois que seus bytes estão no bloco
+    __dmb();
+    bloco->pontos++;
+    anel->total++;
+}
+
+// Número do ponto mais antigo ainda guardado
+static uint32_t anel_mais_antigo(const hist_anel_t *anel) {
+    if (anel->ocupados == 0) {
+        return anel->total;
+    }
+    uint8_t indice = (anel->atual + anel->num_blocos - (anel->ocupados - 1)) % anel->num_blocos;
+    return anel->blocos[indice].primeiro;
+}
+
+// Decodifica o ponto seguinte do bloco atual do leitor
+static bool leitor_decodificar(const hist_anel_t *anel, hist_leitor_t *leitor, int16_t *valores) {
+    const hist_bloco_t *bloco = &anel->blocos[leitor->bloco];
+    uint32_t posicao = leitor->ponto - leitor->primeiro;
+
+    if (posicao >= 2) {
+        // Corrida em andamento: "pos" fica no byte da contagem até que todos
+        // os seus pontos sejam lidos, pois o escritor pode estendê-la
+        if (leitor->corrida > 0 && leitor->corrida >= bloco->dados[leitor->pos]) {
+            leitor->pos++;
+            leitor->corrida = 0;
+        }
+        bool longa = false;
+        if (leitor->corrida == 0 && leitor->pos + 1 < HIST_BLOCO_BYTES && bloco->dados[leitor->pos] == 0) {
+            leitor->pos++;                    // Corrida longa: pula o escape
+            longa = true;
+        }
+        if (leitor->corrida > 0 || longa ||
+            (leitor->pos < HIST_BLOCO_BYTES && bloco->dados[leitor->pos] < HIST_LITERAL)) {
+            leitor->corrida++;
+            for (uint8_t c = 0; c < anel->campos; c++) {
+                leitor->valor[c] = (int16_t)(leitor->valor[c] + leitor->delta[c]);
+                valores[c] = leitor->valor[c];
+            }
+            leitor->ponto++;
+            return true;
+        }
+    }
+
+    for (uint8_t c = 0; c < anel->campos; c++) {
+        uint32_t z;
+        if (!varint_ler(bloco->dados, HIST_BLOCO_BYTES, &leitor->pos, &z)) {
+            leitor->valido = false;
+            return false;
+        }
+        if (c == 0 && posicao >= 2) {
+            z -= HIST_LITERAL;
+        }
+        int32_t v = dezigzag(z);
+        if (posicao == 0) {
+            leitor->delta[c] = 0;
+            leitor->valor[c] = (int16_t)v;
+        } else {
+            leitor->delta[c] = posicao == 1 ? v : leitor->delta[c] + v;
+            leitor->valor[c] = (int16_t)(leitor->valor[c] + leitor->delta[c]);
+        }
+        valores[c] = leitor->valor[c];
+    }
+    leitor->ponto++;
+    return true;
+}
+
+// Posiciona o leitor no ponto "alvo" (ou no mais antigo ainda guardado)
+static void leitor_buscar(const hist_anel_t *anel, hist_leitor_t *leitor, uint32_t alvo) {
+    int16_t descarte[HIST_MAX_CAMPOS];
+    uint32_t antigo = anel_mais_antigo(anel);
+
+    if (alvo < antigo) {
+        alvo = antigo;
+    }
+    leitor->valido = false;
+    leitor->ponto = alvo;
+
+    // Procura do bloco mais novo para o mais antigo
+    for (uint8_t i = 0; i < anel->ocupados; i++) {
+        uint8_t indice = (anel->atual + anel->num_blocos - i) % anel->num_blocos;
+        const hist_bloco_t *bloco = &anel->blocos[indice];
+        if (bloco->pontos == 0 || bloco->primeiro > alvo) {
+            continue;
+        }
+
+        leitor->bloco = indice;
+        leitor->pos = 0;
+        leitor->corrida = 0;
+        leitor->primeiro = bloco->primeiro;
+        leitor->ponto = bloco->primeiro;
+        leitor->valido = true;
+
+        // Avança dentro do bloco até o ponto desejado
+        while (leitor->valido && leitor->ponto < alvo && leitor->ponto - leitor->primeiro < bloco->pontos) {
+            leitor_decodificar(anel, leitor, descarte);
+        }
+        return;
+    }
+}
+
+// Decodifica o próximo ponto. Retorna false quando não há mais pontos.
+static bool leitor_proximo(const hist_anel_t *anel, hist_leitor_t *leitor, int16_t *valores) {
+    const hist_bloco_t *bloco = &anel->blocos[leitor->bloco];
+
+    // Leitor ainda não posicionado ou bloco reutilizado desde a última leitura
+    if (!leitor->valido || bloco->primeiro != leitor->primeiro) {
+        leitor_buscar(anel, leitor, leitor->ponto);
+        if (!leitor->valido) {
+            return false;
+        }
+        bloco = &anel->blocos[leitor->bloco];
+    }
+
+    // Bloco esgotado: segue para o próximo, se ele continuar a sequência
+    if (leitor->ponto - leitor->primeiro >= bloco->pontos) {
+        uint8_t proximo = (leitor->bloco + 1) % anel->num_blocos;
+        const hist_bloco_t *seguinte = &anel->blocos[proximo];
+        if (leitor->bloco == anel->atual || seguinte->pontos == 0 || seguinte->primeiro != leitor->ponto) {
+            return false;
+        }
+        leitor->bloco = proximo;
+        leitor->pos = 0;
+        leitor->corrida = 0;
+        leitor->primeiro = seguinte->primeiro;
+    }
+
+    return leitor_decodificar(anel, leitor, valores);
+}
+
+/* ========== RESUMOS ========== */
+
+static void acum_somar(hist_acum_t *acum, int16_t min, int16_t max, int32_t soma, uint16_t n) {
+    if (acum->n == 0 || min < acum->min) acum->min = min;
+    if (acum->n == 0 || max > acum->max) acum->max = max;
+    acum->soma += soma;
+    acum->n += n;
+}
+
+static hist_resumo_t acum_fechar(hist_acum_t *acum) {
+    hist_resumo_t r;
+    int32_t meio = acum->n / 2;
+
+    r.min = acum->min;
+    r.max = acum->max;
+    r.media = (int16_t)((acum->soma >= 0 ? acum->soma + meio : acum->soma - meio) / acum->n);
+
+    memset(acum, 0, sizeof(*acum));
+    return r;
+}
+
+static void anel_adicionar_resumo(hist_anel_t *anel, hist_resumo_t r) {
+    int16_t valores[HIST_MAX_CAMPOS] = { r.min, r.max, r.media };
+    anel_adicionar(anel, valores);
+}
+
+// Acrescenta uma amostra de 1 s à série, atualizando os resumos em O(1)
+static void serie_amostrar(hist_dados_t *d, int16_t valor) {
+    anel_adicionar(&d->aneis[HIST_RES_1S], &valor);
+
+    acum_somar(&d->acum_1min, valor, valor, valor, 1);
+    if (d->acum_1min.n < 60) {
+        return;
+    }
+
+    // Fecha o minuto e o repassa ao acumulador de 15 minutos
+    int32_t soma_minuto = d->acum_1min.soma;
+    hist_resumo_t minuto = acum_fechar(&d->acum_1min);
+    anel_adicionar_resumo(&d->aneis[HIST_RES_1MIN], minuto);
+
+    acum_somar(&d->acum_15min, minuto.min, minuto.max, soma_minuto, 60);
+    if (d->acum_15min.n < 900) {
+        return;
+    }
+
+    anel_adicionar_resumo(&d->aneis[HIST_RES_15MIN], acum_fechar(&d->acum_15min));
+}
+
+static void historico_iniciar(void) {
+    for (int i = 0; i < HIST_NUM_SERIES; i++) {
+        hist_dados_t *d = &dados[i];
+        anel_configurar(&d->aneis[HIST_RES_1S], d->b1s, HIST_BLOCOS_1S, 1);
+        anel_configurar(&d->aneis[HIST_RES_1MIN], d->b1min, HIST_BLOCOS_1MIN, 3);
+        anel_configurar(&d->aneis[HIST_RES_15MIN], d->b15min, HIST_BLOCOS_15MIN, 3);
+    }
+    iniciado = true;
+}
+
+// Registra uma amostra de cada série. Deve ser chamada uma vez por segundo,
+// apenas pelo loop principal.
+void historico_amostrar(const int16_t valores[HIST_NUM_SERIES]) {
+    if (!iniciado) {
+        historico_iniciar();
+    }
+    for (int i = 0; i < HIST_NUM_SERIES; i++) {
+        serie_amostrar(&dados[i], valores[i]);
+    }
+}
+
+/* ========== EXPORTAÇÃO ========== */
+
+// Converte o nome usado na API para o índice da série (-1 se desconhecido)
+int historico_serie_de_nome(const char *nome) {
+    for (int i = 0; i < HIST_NUM_SERIES; i++) {
+        if (strcmp(nome, nomes_serie[i]) == 0) return i;
+    }
+    return -1;
+}
+
+// Converte o nome usado na API para a resolução (-1 se desconhecido)
+int historico_res_de_nome(const char *nome) {
+    for (int i = 0; i < HIST_NUM_RES; i++) {
+        if (strcmp(nome, nomes_res[i]) == 0) return i;
+    }
+    return -1;
+}
+
+// Prepara a exportação de todos os pontos disponíveis no momento
+void historico_cursor_iniciar(hist_cursor_t *cursor, hist_serie_t serie, hist_res_t res) {
+    cursor->serie = serie;
+    cursor->res = res;
+    cursor->etapa = ETAPA_CABECALHO;
+    cursor->primeiro = true;
+    cursor->fim = 0;
+    cursor->leitor.valido = false;
+    cursor->leitor.ponto = 0;
+
+    if (iniciado) {
+        const hist_anel_t *anel = &dados[serie].aneis[res];
+        cursor->fim = anel->total;
+        leitor_buscar(anel, &cursor->leitor, 0);
+    }
+}
+
+bool historico_cursor_concluido(const hist_cursor_t *cursor) {
+    return cursor->etapa == ETAPA_CONCLUIDA;
+}
+
+// Descomprime e formata o próximo ponto. Retorna false se não houver mais.
+static bool formatar_ponto(hist_cursor_t *cursor, char *texto, size_t tamanho) {
+    const hist_anel_t *anel = &dados[cursor->serie].aneis[cursor->res];
+    const char *separador = cursor->primeiro ? "" : ",";
+    int16_t v[HIST_MAX_CAMPOS];
+
+    if (!iniciado || cursor->leitor.ponto >= cursor->fim || !leitor_proximo(anel, &cursor->leitor, v)) {
+        return false;
+    }
+
+    if (cursor->res == HIST_RES_1S) {
+        snprintf(texto, tamanho, "%s%d", separador, v[0]);
+    } else {
+        snprintf(texto, tamanho, "%s[%d,%d,%d]", separador, v[0], v[1], v[2]);
+    }
+    return true;
+}
+
+// Escreve em "destino" o próximo trecho do JSON da série, sem cortar
+// elementos no meio. Retorna o número de bytes escritos; 0 com o cursor
+// ainda não concluído indica que o espaço foi insuficiente.
+size_t historico_exportar_json(hist_cursor_t *cursor, char *destino, size_t tamanho) {
+    char texto[128];
+    size_t usado = 0;
+
+    while (cursor->etapa != ETAPA_CONCLUIDA) {
+        hist_leitor_t anterior = cursor->leitor;
+
+        if (cursor->etapa == ETAPA_CABECALHO) {
+            snprintf(texto, sizeof(texto),
+                     "{\"serie\":\"%s\",\"res\":\"%s\",\"periodo_s\":%u,\"unidade\":\"%s\",\"pontos\":[",
+                     nomes_serie[cursor->serie], nomes_res[cursor->res],
+                     periodo_res_s[cursor->res], unidades_serie[cursor->serie]);
+        } else if (cursor->etapa == ETAPA_PONTOS) {
+            if (!formatar_ponto(cursor, texto, sizeof(texto))) {
+                cursor->etapa = ETAPA_RODAPE;
+                continue;
+            }
+        } else {
+            strcpy(texto, "]}");
+        }
+
+        size_t n = strlen(texto);
+        if (usado + n > tamanho) {
+            // Não coube: desfaz a decodificação para repetir na próxima chamada
+            cursor->leitor = anterior;
+            break;
+        }
+        memcpy(destino + usado, texto, n);
+        usado += n;
+
+        if (cursor->etapa == ETAPA_PONTOS) {
+            cursor->primeiro = false;
+        } else {
+            cursor->etapa++;
+        }
+    }
+
+    return usado;
+}
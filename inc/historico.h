@@ -0,0 +1,80 @@
+#ifndef HISTORICO_H
+#define HISTORICO_H
+
+#include <stddef.h>
+#include "pico/stdlib.h"
+#include "layout_matriz.h"
+
+// Séries guardadas no histórico. Todas usam valores inteiros de 16 bits.
+// Cada dispositivo tem a sua série, com 100 ligado e 0 desligado: a média
+// de um resumo é a porcentagem do intervalo em que ele ficou ligado.
+typedef enum {
+    HIST_TEMPERATURA,     // Centésimos de °C
+    HIST_DISTANCIA,       // Milímetros
+    HIST_LUZ,             // Nível de luz (0 = escuro, 4095 = claro)
+    HIST_TELEVISAO,       // Display da TV ligado
+    HIST_COMODOS,         // Luz de cada cômodo: HIST_COMODOS + comodo_t
+    HIST_NUM_SERIES = HIST_COMODOS + NUM_COMODOS
+} hist_serie_t;
+
+// Resoluções disponíveis: amostras brutas e resumos de 1 e 15 minutos
+typedef enum {
+    HIST_RES_1S,
+    HIST_RES_1MIN,
+    HIST_RES_15MIN,
+    HIST_NUM_RES
+} hist_res_t;
+
+// Os pontos são guardados comprimidos (delta-de-delta + zigzag + varint, com
+// corridas de delta-de-delta zero) em blocos de tamanho fixo. Cada resolução
+// tem seu anel de blocos; quando ele enche, o bloco mais antigo é descartado
+// inteiro. A retenção depende de quão estável é a série: um ponto com ruído
+// gasta cerca de 1 byte por campo, e um trecho parado ou em rampa constante,
+// 2 bytes a cada 255 pontos. As quantidades abaixo mantêm cerca de 1,2 KB por
+// série, como os anéis sem compressão (2 min, 1 h e 24 h). Medido com ruído
+// de 1 LSB na temperatura, cada anel guarda:
+#define HIST_BLOCO_BYTES     48
+#define HIST_BLOCOS_1S       4     // Cerca de 2 min a 1 s (4 h num dispositivo ligado/desligado)
+#define HIST_BLOCOS_1MIN     5     // Cerca de 1,1 h a 1 min (7 h num dispositivo)
+#define HIST_BLOCOS_15MIN    10    // Cerca de 37 h a 15 min (mais de 8 dias com distância e luz estáveis)
+#define HIST_MAX_CAMPOS      3     // Mínimo, máximo e média nos resumos
+
+// Resumo de um intervalo
+typedef struct {
+    int16_t min, max, media;
+} hist_resumo_t;
+
+// Estado do decodificador de um anel comprimido
+typedef struct {
+    uint8_t bloco;                    // Bloco sendo lido
+    uint8_t pos;                      // Próximo byte dentro do bloco
+    uint8_t corrida;                  // Pontos já lidos da corrida em "pos"
+    uint32_t primeiro;                // Primeiro ponto do bloco (detecta reuso)
+    uint32_t ponto;                   // Número absoluto do próximo ponto
+    int16_t valor[HIST_MAX_CAMPOS];   // Último valor decodificado de cada campo
+    int32_t delta[HIST_MAX_CAMPOS];   // Última diferença de cada campo
+    bool valido;
+} hist_leitor_t;
+
+// Posição de uma exportação em andamento. Os pontos só são descomprimidos
+// aqui, à medida que a resposta é enviada; várias exportações podem correr
+// em paralelo sem alocar memória.
+typedef struct {
+    hist_serie_t serie;
+    hist_res_t res;
+    uint8_t etapa;        // Cabeçalho, pontos, rodapé ou concluída
+    uint32_t fim;         // Total de pontos quando a exportação começou
+    hist_leitor_t leitor;
+    bool primeiro;
+} hist_cursor_t;
+
+void historico_amostrar(const int16_t valores[HIST_NUM_SERIES]);
+
+int historico_serie_de_nome(const char *nome);
+int historico_res_de_nome(const char *nome);
+
+void historico_cursor_iniciar(hist_cursor_t *cursor, hist_serie_t serie, hist_res_t res);
+size_t historico_exportar_json(hist_cursor_t *cursor, char *destino, size_t tamanho);
+bool historico_cursor_concluido(const hist_cursor_t *cursor);
+
+#endif
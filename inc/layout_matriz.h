@@ -0,0 +1,50 @@
+#ifndef LAYOUT_MATRIZ_H
+#define LAYOUT_MATRIZ_H
+
+#include <stdint.h>
+
+// Layout dos cômodos na matriz de LEDs, declarado uma única vez.
+// Cada cômodo lista os pixels que ocupa (posição do LED no quadro, contando
+// todas as saídas), em qualquer formato: linhas, colunas ou pixels soltos.
+// Um pixel que aparece em mais de um cômodo pertence ao primeiro da lista;
+// pixels sem cômodo ficam apagados. As listas são geradas na compilação e não
+// limitam o tamanho da matriz.
+
+// X(identificador, nome usado na API, pixels...)
+#define LAYOUT_COMODOS(X) \
+    X(SALA,     "sala",     20, 21, 22, 23, 24) \
+    X(COZINHA,  "cozinha",  15, 16, 17, 18, 19) \
+    X(QUARTO,   "quarto",   10, 11, 12, 13, 14) \
+    X(BANHEIRO, "banheiro", 5,  6,  7,  8,  9) \
+    X(QUINTAL,  "quintal",  0,  1,  2,  3,  4)
+
+// Índice de cada cômodo (COMODO_SALA, ...)
+#define LAYOUT_X_ENUM(id, nome, ...) COMODO_##id,
+typedef enum {
+    LAYOUT_COMODOS(LAYOUT_X_ENUM)
+    NUM_COMODOS
+} comodo_t;
+
+// Nome de cada cômodo na API
+#define LAYOUT_X_NOME(id, nome, ...) nome,
+static const char *const nomes_comodos[NUM_COMODOS] = {
+    LAYOUT_COMODOS(LAYOUT_X_NOME)
+};
+
+// Lista de pixels de cada cômodo (layout_pixels_SALA, ...)
+#define LAYOUT_X_LISTA(id, nome, ...) static const uint16_t layout_pixels_##id[] = { __VA_ARGS__ };
+LAYOUT_COMODOS(LAYOUT_X_LISTA)
+
+typedef struct {
+    const uint16_t *pixels;
+    uint16_t quantidade;
+} layout_comodo_t;
+
+// Pixels de cada cômodo, indexados por comodo_t
+#define LAYOUT_X_COMODO(id, nome, ...) \
+    { layout_pixels_##id, sizeof(layout_pixels_##id) / sizeof(layout_pixels_##id[0]) },
+static const layout_comodo_t pixels_comodo[NUM_COMODOS] = {
+    LAYOUT_COMODOS(LAYOUT_X_COMODO)
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "ldr.h"
+
+// Estimativa de iluminância por faixa de leitura do ADC (passo de 128).
+// Calculada para um LDR GL5528 (cerca de 15 kΩ a 10 lux, gama 0,6) ligado ao
+// 3,3 V com resistor de 10 kΩ para o GND; serve apenas como ordem de grandeza.
+static const uint32_t lux_por_faixa[33] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 4, 5, 7, 8, 10, 13, 16, 20,
+    24, 30, 37, 46, 58, 73, 94, 123, 164, 227, 328, 505, 866, 1805, 6092, 100000
+};
+
+// Nível filtrado com 4 bits extras de precisão
+static volatile uint32_t nivel_q4 = 0;
+static volatile bool escuro = false;
+static bool primeira_leitura = true;
+
+static uint16_t limiar_escuro = LDR_LIMIAR_ESCURO;
+static uint16_t limiar_claro = LDR_LIMIAR_CLARO;
+
+// Define os limiares iniciais de histerese
+void ldr_init(uint16_t escuro_abaixo, uint16_t claro_acima) {
+    ldr_set_limiares(escuro_abaixo, claro_acima);
+    primeira_leitura = true;
+}
+
+// Altera os limiares; o limiar de claro nunca fica abaixo do de escuro
+void ldr_set_limiares(uint16_t escuro_abaixo, uint16_t claro_acima) {
+    if (claro_acima < escuro_abaixo) {
+        claro_acima = escuro_abaixo;
+    }
+    limiar_escuro = escuro_abaixo;
+    limiar_claro = claro_acima;
+}
+
+// Recebe uma leitura bruta do ADC. Chamada pelo amostrador em segundo plano.
+void ldr_processar(uint16_t bruto) {
+    uint32_t filtrado;
+
+    if (primeira_leitura) {
+        filtrado = (uint32_t)bruto << 4;
+        primeira_leitura = false;
+    } else {
+        // Média móvel exponencial: filtrado += (bruto - filtrado) / 2^shift
+        int32_t diferenca = ((int32_t)bruto << 4) - (int32_t)nivel_q4;
+        filtrado = (uint32_t)((int32_t)nivel_q4 + (diferenca >> LDR_FILTRO_SHIFT));
+    }
+    nivel_q4 = filtrado;
+
+    // Histerese: só troca de estado ao cruzar o limiar do lado oposto
+    uint16_t nivel = (uint16_t)(filtrado >> 4);
+    if (escuro && nivel > limiar_claro) {
+        escuro = false;
+    } else if (!escuro && nivel < limiar_escuro) {
+        escuro = true;
+    }
+}
+
+// Nível de luz filtrado (0 = escuro, 4095 = claro)
+uint16_t ldr_nivel(void) {
+    return (uint16_t)(nivel_q4 >> 4);
+}
+
+// Estado do ambiente com histerese
+bool ldr_escuro(void) {
+    return escuro;
+}
+
+// Estimativa aproximada em lux, interpolando a tabela por faixas
+uint32_t ldr_lux(void) {
+    uint32_t nivel = ldr_nivel();
+    uint32_t faixa = nivel >> 7;
+    uint32_t resto = nivel & 0x7F;
+    uint32_t a = lux_por_faixa[faixa];
+    uint32_t b = lux_por_faixa[faixa + 1];
+
+    return a + (((b - a) * resto) >> 7);
+}
@@ -0,0 +1,23 @@
+#ifndef LDR_H
+#define LDR_H
+
+#include "pico/stdlib.h"
+
+// Limiares padrão (nível filtrado de 0 a 4095). Abaixo de LDR_LIMIAR_ESCURO o
+// ambiente passa a ser considerado escuro e só volta a claro acima de
+// LDR_LIMIAR_CLARO; a faixa entre os dois evita oscilações ao anoitecer.
+#define LDR_LIMIAR_ESCURO 1200
+#define LDR_LIMIAR_CLARO  1600
+
+// Peso de cada nova leitura no filtro (1 / 2^LDR_FILTRO_SHIFT)
+#define LDR_FILTRO_SHIFT 4
+
+void ldr_init(uint16_t limiar_escuro, uint16_t limiar_claro);
+void ldr_set_limiares(uint16_t limiar_escuro, uint16_t limiar_claro);
+void ldr_processar(uint16_t bruto);
+
+uint16_t ldr_nivel(void);
+bool ldr_escuro(void);
+uint32_t ldr_lux(void);
+
+#endif
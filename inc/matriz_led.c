@@ -0,0 +1,226 @@
+#include <string.h>
+#include "matriz_led.h"
+#include "hardware/clocks.h"
+#include "animacoes_led.pio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+// Quadros de todas as saídas: uma palavra GRB por LED, alinhada nos 24 bits
+// superiores. Quem desenha escreve sempre no quadro de trás; o DMA só lê o
+// da frente, que é trocado inteiro num único passo ao publicar.
+static uint32_t paginas[2][MATRIZ_MAX_PIXELS];
+static uint32_t *volatile frente = paginas[0];
+static uint32_t *volatile tras = paginas[1];
+static uint pixels;
+
+static bool forcar_envio = true;
+
+// Quadros efetivamente transmitidos e quadros descartados por não mudarem
+static uint32_t quadros_enviados = 0;
+static uint32_t quadros_ignorados = 0;
+
+// Frequência dos bits e pausa que faz os LEDs aplicarem o quadro, por perfil
+static const struct {
+    uint freq_bit_hz;
+    uint reset_us;
+} perfis[MATRIZ_NUM_PERFIS] = {
+    [MATRIZ_WS2812] = { 800000, 300 },
+    [MATRIZ_SK6812] = { 800000, 100 },
+    [MATRIZ_WS2811] = { 400000, 300 },
+};
+
+// Máquina de estados, canal de DMA e faixa do quadro de cada saída
+typedef struct {
+    PIO pio;
+    uint sm;
+    uint canal;
+    uint inicio;
+    uint num_pixels;
+    matriz_formato_t formato;
+} saida_t;
+
+static saida_t saidas[MATRIZ_MAX_SAIDAS];
+static uint num_saidas = 0;
+
+// Verdadeiro do início do DMA até o fim da pausa de reset dos LEDs
+static volatile bool ocupada = false;
+
+// Canais de DMA do quadro atual que ainda não terminaram
+static volatile uint32_t canais_pendentes = 0;
+
+// Tempo até a FIFO esvaziar e a pausa de reset terminar, contado a partir
+// do fim do último DMA. É o maior entre as saídas configuradas.
+static uint32_t espera_fim_us;
+
+// Fim da pausa de reset: os LEDs já aplicaram o quadro
+static int64_t fim_reset(alarm_id_t id, void *dados) {
+    ocupada = false;
+    return 0;
+}
+
+// Fim de uma transferência. As saídas transmitem em paralelo; a liberação só
+// é agendada quando o último canal do quadro termina.
+static void matriz_dma_irq(void) {
+    bool terminou = false;
+
+    for (uint i = 0; i < num_saidas; i++) {
+        uint canal = saidas[i].canal;
+        if (dma_channel_get_irq0_status(canal)) {
+            dma_channel_acknowledge_irq0(canal);
+            canais_pendentes &= ~(1u << canal);
+            terminou = true;
+        }
+    }
+
+    // Sem alarme livre, espera a pausa aqui mesmo: do contrário a matriz
+    // ficaria ocupada para sempre
+    if (terminou && canais_pendentes == 0 && add_alarm_in_us(espera_fim_us, fim_reset, NULL, true) < 0) {
+        busy_wait_us_32(espera_fim_us);
+        ocupada = false;
+    }
+}
+
+// Carrega o programa uma vez por bloco PIO e devolve o seu endereço. Cada
+// posição guarda o endereço + 1, para que 0 signifique "não carregado".
+static uint carregar_programa(PIO pio) {
+    static uint offsets[NUM_PIOS];
+    uint indice = pio_get_index(pio);
+
+    if (offsets[indice] == 0) {
+        offsets[indice] = pio_add_program(pio, &animacoes_led_program) + 1;
+    }
+    return offsets[indice] - 1;
+}
+
+// Configura uma máquina de estados e um canal de DMA para cada saída.
+// Os LEDs de cada saída ocupam posições consecutivas do quadro.
+void matriz_init(const matriz_saida_cfg_t *cfg, uint quantidade) {
+    if (quantidade > MATRIZ_MAX_SAIDAS) {
+        quantidade = MATRIZ_MAX_SAIDAS;
+    }
+
+    pixels = 0;
+    num_saidas = 0;
+    espera_fim_us = 0;
+    for (uint i = 0; i < quantidade && pixels < MATRIZ_MAX_PIXELS; i++) {
+        saida_t *s = &saidas[num_saidas++];
+
+        s->pio = cfg[i].pio;
+        s->sm = pio_claim_unused_sm(s->pio, true);
+        s->inicio = pixels;
+        s->num_pixels = cfg[i].num_pixels;
+        if (s->num_pixels > MATRIZ_MAX_PIXELS - pixels) {
+            s->num_pixels = MATRIZ_MAX_PIXELS - pixels;
+        }
+        pixels += s->num_pixels;
+        s->formato = cfg[i].formato;
+
+        uint bits = cfg[i].formato == MATRIZ_GRBW ? 32 : 24;
+        uint freq = perfis[cfg[i].perfil].freq_bit_hz;
+        animacoes_led_program_init(s->pio, s->sm, carregar_programa(s->pio), cfg[i].pino, bits, freq);
+
+        // A FIFO unida de TX guarda 8 pixels, mais um no OSR
+        uint32_t espera = (9 * bits * 1000000u) / freq + perfis[cfg[i].perfil].reset_us;
+        if (espera > espera_fim_us) {
+            espera_fim_us = espera;
+        }
+
+        s->canal = dma_claim_unused_channel(true);
+        dma_channel_config c = dma_channel_get_default_config(s->canal);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pio_get_dreq(s->pio, s->sm, true));
+        dma_channel_configure(s->canal, &c, &s->pio->txf[s->sm],
+                              &frente[s->inicio], s->num_pixels, false);
+        dma_channel_set_irq0_enabled(s->canal, true);
+    }
+
+    irq_add_shared_handler(DMA_IRQ_0, matriz_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+// Soma dos LEDs de todas as saídas configuradas
+uint matriz_num_pixels(void) {
+    return pixels;
+}
+
+// Formato da saída que transmite o pixel, para quem compõe o quadro
+// escolher a conversão de cor (GRB fora das saídas configuradas)
+matriz_formato_t matriz_formato_pixel(uint pixel) {
+    for (uint i = 0; i < num_saidas; i++) {
+        if (pixel - saidas[i].inicio < saidas[i].num_pixels) {
+            return saidas[i].formato;
+        }
+    }
+    return MATRIZ_GRB;
+}
+
+// Quadro de trás, onde o próximo quadro é composto. Pode ser alterado a
+// qualquer momento, mesmo durante um envio; começa com o último publicado.
+uint32_t *matriz_quadro(void) {
+    return tras;
+}
+
+// Publica o quadro de trás e inicia o seu envio por DMA, retornando
+// imediatamente. Só as saídas cuja faixa mudou são transmitidas, todas ao
+// mesmo tempo; o quadro leva o tempo da saída mais longa. Retorna false,
+// sem publicar, se o quadro anterior ainda estiver em envio.
+bool matriz_enviar(void) {
+    if (ocupada) {
+        return false;
+    }
+
+    uint32_t mascara = 0;
+    for (uint i = 0; i < num_saidas; i++) {
+        const saida_t *s = &saidas[i];
+        size_t bytes = s->num_pixels * sizeof(uint32_t);
+
+        if (forcar_envio || memcmp(&tras[s->inicio], &frente[s->inicio], bytes) != 0) {
+            mascara |= 1u << s->canal;
+        }
+    }
+
+    if (mascara == 0) {
+        quadros_ignorados++;
+        return true;
+    }
+
+    // Troca as páginas: o quadro composto passa a ser o lido pelo DMA
+    uint32_t *publicado = tras;
+    tras = frente;
+    frente = publicado;
+
+    for (uint i = 0; i < num_saidas; i++) {
+        const saida_t *s = &saidas[i];
+        if (mascara & (1u << s->canal)) {
+            // O novo quadro de trás parte do que acabou de ser publicado
+            memcpy(&tras[s->inicio], &frente[s->inicio], s->num_pixels * sizeof(uint32_t));
+            dma_channel_set_read_addr(s->canal, &frente[s->inicio], false);
+            dma_channel_set_trans_count(s->canal, s->num_pixels, false);
+        }
+    }
+
+    forcar_envio = false;
+    quadros_enviados++;
+
+    ocupada = true;
+    canais_pendentes = mascara;
+    dma_start_channel_mask(mascara);
+    return true;
+}
+
+bool matriz_ocupada(void) {
+    return ocupada;
+}
+
+// Faz o próximo matriz_enviar transmitir mesmo sem mudanças no quadro
+void matriz_forcar_atualizacao(void) {
+    forcar_envio = true;
+}
+
+// Contadores de quadros transmitidos e ignorados desde o boot
+void matriz_estatisticas(uint32_t *enviados, uint32_t *ignorados) {
+    *enviados = quadros_enviados;
+    *ignorados = quadros_ignorados;
+}
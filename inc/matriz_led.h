@@ -0,0 +1,51 @@
+#ifndef MATRIZ_LED_H
+#define MATRIZ_LED_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// Total de LEDs somando todas as saídas. O quadro é um só: cada saída
+// transmite uma faixa contígua dele, na ordem em que foi configurada.
+// Definido pela opção MATRIZ_MAX_PIXELS do CMake; o valor abaixo só vale
+// para quem compila o módulo fora do projeto.
+#ifndef MATRIZ_MAX_PIXELS
+#define MATRIZ_MAX_PIXELS 25
+#endif
+
+// Cada saída usa uma máquina de estados (4 por bloco PIO) e um canal de DMA
+#define MATRIZ_MAX_SAIDAS 8
+
+// Formato das palavras do quadro. Os bytes são transmitidos do mais
+// significativo para o menos: G, R, B e, nas fitas RGBW, o branco.
+typedef enum {
+    MATRIZ_GRB,         // 24 bits (WS2812 e similares)
+    MATRIZ_GRBW,        // 32 bits (SK6812 RGBW)
+} matriz_formato_t;
+
+// Temporização do protocolo de cada família de LEDs
+typedef enum {
+    MATRIZ_WS2812,      // 800 kHz, reset de 280 us nas versões recentes
+    MATRIZ_SK6812,      // 800 kHz, reset de 80 us
+    MATRIZ_WS2811,      // 400 kHz (modo lento), reset de 280 us
+    MATRIZ_NUM_PERFIS
+} matriz_perfil_t;
+
+// Uma fita ou matriz ligada a um pino
+typedef struct {
+    PIO pio;                    // Bloco PIO que gera o sinal (pio0 ou pio1)
+    uint pino;                  // GPIO de dados
+    uint num_pixels;            // LEDs nesta saída
+    matriz_formato_t formato;
+    matriz_perfil_t perfil;
+} matriz_saida_cfg_t;
+
+void matriz_init(const matriz_saida_cfg_t *saidas, uint num_saidas);
+uint matriz_num_pixels(void);
+matriz_formato_t matriz_formato_pixel(uint pixel);
+uint32_t *matriz_quadro(void);
+bool matriz_enviar(void);
+bool matriz_ocupada(void);
+void matriz_forcar_atualizacao(void);
+void matriz_estatisticas(uint32_t *enviados, uint32_t *ignorados);
+
+#endif
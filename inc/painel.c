@@ -0,0 +1,438 @@
+#include "painel.h"
+#include <stdio.h>
+#include <string.h>
+
+// Amostras de um gráfico. O anel guarda uma amostra além da largura: a
+// primeira coluna visível ainda liga à anterior, como quando foi desenhada.
+typedef struct {
+    int16_t amostras[PAINEL_GRAFICO_MAX_COLUNAS + 1];
+    uint8_t proxima;                  // Posição da próxima amostra no anel
+    uint8_t quantidade;
+    uint8_t pendentes;                // Amostras novas ainda não desenhadas
+    uint8_t ultima_linha;             // Linha da amostra mais recente na tela
+    int32_t minimo, maximo;
+    bool automatico;
+} grafico_t;
+
+typedef struct {
+    painel_tipo_t tipo;
+    uint8_t x, y, largura, altura;
+    bool visivel;
+    bool desenhado;                   // Aparece no buffer do display
+    bool sujo;                        // Precisa ser redesenhado
+
+    painel_alinhamento_t alinhamento;
+    char texto[PAINEL_MAX_TEXTO];     // Rótulo ou valor já formatado
+    const char *unidade;
+    uint8_t decimais;
+
+    const uint8_t *colunas;           // Ícone
+
+    int32_t minimo, maximo;           // Barra
+    uint8_t preenchido;               // Colunas cheias da barra
+
+    grafico_t *grafico;
+} widget_t;
+
+static ssd1306_t *display;
+static widget_t widgets[PAINEL_MAX_WIDGETS];
+static uint8_t num_widgets = 0;
+static grafico_t graficos[PAINEL_MAX_GRAFICOS];
+static uint8_t num_graficos = 0;
+
+static inline uint8_t capacidade(const widget_t *w) {
+    return w->largura + 1;
+}
+
+// Posição no anel da n-ésima amostra contando da mais recente para trás (n >= 1)
+static inline uint8_t amostra_anterior(const widget_t *w, uint8_t n) {
+    return (w->grafico->proxima + capacidade(w) - n) % capacidade(w);
+}
+
+void painel_init(ssd1306_t *ssd) {
+    display = ssd;
+    num_widgets = 0;
+    num_graficos = 0;
+}
+
+static widget_t *novo_widget(painel_tipo_t tipo, uint8_t x, uint8_t y, uint8_t largura, uint8_t altura,
+                             painel_id_t *id) {
+    if (num_widgets >= PAINEL_MAX_WIDGETS) {
+        *id = -1;
+        return NULL;
+    }
+
+    *id = num_widgets;
+    widget_t *w = &widgets[num_widgets++];
+    memset(w, 0, sizeof(*w));
+    w->tipo = tipo;
+    w->x = x;
+    w->y = y;
+    w->largura = largura;
+    w->altura = altura;
+    w->visivel = true;
+    w->sujo = true;
+    return w;
+}
+
+static widget_t *widget(painel_id_t id) {
+    return (id >= 0 && id < num_widgets) ? &widgets[id] : NULL;
+}
+
+painel_id_t painel_rotulo(uint8_t x, uint8_t y, uint8_t largura, painel_alinhamento_t alinhamento, const char *texto) {
+    painel_id_t id;
+    widget_t *w = novo_widget(PAINEL_ROTULO, x, y, largura, 8, &id);
+    if (w) {
+        w->alinhamento = alinhamento;
+        snprintf(w->texto, sizeof(w->texto), "%s", texto);
+    }
+    return id;
+}
+
+painel_id_t painel_valor(uint8_t x, uint8_t y, uint8_t largura, painel_alinhamento_t alinhamento,
+                         uint8_t decimais, const char *unidade) {
+    painel_id_t id;
+    widget_t *w = novo_widget(PAINEL_VALOR, x, y, largura, 8, &id);
+    if (w) {
+        w->alinhamento = alinhamento;
+        w->decimais = decimais < PAINEL_MAX_DECIMAIS ? decimais : PAINEL_MAX_DECIMAIS;
+        w->unidade = unidade ? unidade : "";
+    }
+    return id;
+}
+
+painel_id_t painel_icone(uint8_t x, uint8_t y, const uint8_t *colunas, uint8_t largura) {
+    painel_id_t id;
+    widget_t *w = novo_widget(PAINEL_ICONE, x, y, largura, 8, &id);
+    if (w) {
+        w->colunas = colunas;
+    }
+    return id;
+}
+
+painel_id_t painel_barra(uint8_t x, uint8_t y, uint8_t largura, uint8_t altura, int32_t minimo, int32_t maximo) {
+    painel_id_t id;
+    widget_t *w = novo_widget(PAINEL_BARRA, x, y, largura, altura, &id);
+    if (w) {
+        w->minimo = minimo;
+        w->maximo = maximo > minimo ? maximo : minimo + 1;
+    }
+    return id;
+}
+
+painel_id_t painel_moldura(uint8_t x, uint8_t y, uint8_t largura, uint8_t altura) {
+    painel_id_t id;
+    novo_widget(PAINEL_MOLDURA, x, y, largura, altura, &id);
+    return id;
+}
+
+painel_id_t painel_grafico(uint8_t x, uint8_t y, uint8_t largura, uint8_t altura, int16_t minimo, int16_t maximo) {
+    painel_id_t id = -1;
+    if (num_graficos >= PAINEL_MAX_GRAFICOS || largura == 0 || largura > PAINEL_GRAFICO_MAX_COLUNAS || altura < 2) {
+        return id;
+    }
+
+    widget_t *w = novo_widget(PAINEL_GRAFICO, x, y, largura, altura, &id);
+    if (w) {
+        grafico_t *g = &graficos[num_graficos++];
+        memset(g, 0, sizeof(*g));
+        g->automatico = minimo >= maximo;
+        g->minimo = minimo;
+        g->maximo = g->automatico ? minimo + 1 : maximo;
+        w->grafico = g;
+    }
+    return id;
+}
+
+void painel_texto(painel_id_t id, const char *texto) {
+    widget_t *w = widget(id);
+    if (!w || strncmp(w->texto, texto, PAINEL_MAX_TEXTO - 1) == 0) {
+        return;
+    }
+    snprintf(w->texto, sizeof(w->texto), "%s", texto);
+    w->sujo = true;
+}
+
+// Valores com casas decimais são passados já multiplicados (ex.: 235 com
+// uma casa = "23,5"). O widget compara o texto formatado, então variações
+// que não aparecem na tela não causam redesenho.
+void painel_definir_valor(painel_id_t id, int32_t valor) {
+    widget_t *w = widget(id);
+    if (!w) {
+        return;
+    }
+
+    if (w->tipo == PAINEL_BARRA) {
+        if (valor < w->minimo) valor = w->minimo;
+        if (valor > w->maximo) valor = w->maximo;
+        uint8_t interior = w->largura > 2 ? w->largura - 2 : 0;
+        uint8_t preenchido = (uint8_t)((int64_t)(valor - w->minimo) * interior / (w->maximo - w->minimo));
+        if (preenchido != w->preenchido) {
+            w->preenchido = preenchido;
+            w->sujo = true;
+        }
+        return;
+    }
+
+    // Cabe o pior caso do número; o que passar da largura do widget é
+    // cortado por painel_texto
+    char texto[sizeof("-4294967295,") + PAINEL_MAX_DECIMAIS + PAINEL_MAX_TEXTO];
+    uint32_t modulo = valor < 0 ? -(uint32_t)valor : (uint32_t)valor;
+    uint8_t decimais = w->decimais < PAINEL_MAX_DECIMAIS ? w->decimais : PAINEL_MAX_DECIMAIS;
+    int n;
+    if (decimais == 0) {
+        n = snprintf(texto, sizeof(texto), "%ld%s", (long)valor, w->unidade);
+    } else {
+        uint32_t divisor = 1;
+        for (uint8_t i = 0; i < decimais; i++) {
+            divisor *= 10;
+        }
+        n = snprintf(texto, sizeof(texto), "%s%lu,%0*lu%s", valor < 0 ? "-" : "",
+                     (unsigned long)(modulo / divisor), (int)decimais, (unsigned long)(modulo % divisor), w->unidade);
+    }
+    if (n < 0) {
+        return;
+    }
+    painel_texto(id, texto);
+}
+
+void painel_definir_icone(painel_id_t id, const uint8_t *colunas) {
+    widget_t *w = widget(id);
+    if (w && w->colunas != colunas) {
+        w->colunas = colunas;
+        w->sujo = true;
+    }
+}
+
+void painel_visivel(painel_id_t id, bool visivel) {
+    widget_t *w = widget(id);
+    if (w && w->visivel != visivel) {
+        w->visivel = visivel;
+        w->sujo = true;
+    }
+}
+
+// Ajusta a escala automática às amostras guardadas, com uma folga acima e
+// abaixo. Só muda quando uma amostra sai da faixa ou quando a faixa ficou
+// muito maior que o necessário; retorna se mudou.
+static bool grafico_escalar(grafico_t *g) {
+    int32_t menor = INT16_MAX, maior = INT16_MIN;
+    for (uint8_t i = 0; i < g->quantidade; i++) {
+        if (g->amostras[i] < menor) menor = g->amostras[i];
+        if (g->amostras[i] > maior) maior = g->amostras[i];
+    }
+
+    int32_t folga = (maior - menor) / 8 + 1;
+    int32_t ideal = maior - menor + 2 * folga;
+    if (menor >= g->minimo && maior <= g->maximo && g->maximo - g->minimo <= 4 * ideal) {
+        return false;
+    }
+    g->minimo = menor - folga;
+    g->maximo = maior + folga;
+    return true;
+}
+
+void painel_grafico_adicionar(painel_id_t id, int16_t valor) {
+    widget_t *w = widget(id);
+    if (!w || w->tipo != PAINEL_GRAFICO) {
+        return;
+    }
+
+    grafico_t *g = w->grafico;
+    g->amostras[g->proxima] = valor;
+    g->proxima = (g->proxima + 1) % capacidade(w);
+    if (g->quantidade < capacidade(w)) {
+        g->quantidade++;
+    }
+
+    if (g->automatico && grafico_escalar(g)) {
+        w->sujo = true;          // Escala nova: redesenha tudo
+    } else if (w->desenhado && g->pendentes < w->largura) {
+        g->pendentes++;          // Só a coluna nova, em painel_renderizar
+    }
+}
+
+// Verdadeiro se b está inteiro dentro da moldura a, sem tocar na borda
+static bool dentro_da_moldura(const widget_t *a, const widget_t *b) {
+    return a->tipo == PAINEL_MOLDURA &&
+           b->x > a->x && b->x + b->largura < a->x + a->largura - 1 &&
+           b->y > a->y && b->y + b->altura < a->y + a->altura - 1;
+}
+
+// Apagar ou desenhar a atinge b? Uma moldura só mexe na própria borda.
+static bool sobrepoe(const widget_t *a, const widget_t *b) {
+    if (a->x >= b->x + b->largura || b->x >= a->x + a->largura ||
+        a->y >= b->y + b->altura || b->y >= a->y + a->altura) {
+        return false;
+    }
+    return !dentro_da_moldura(a, b) && !dentro_da_moldura(b, a);
+}
+
+static void apagar(const widget_t *w) {
+    ssd1306_rect(display, w->y, w->x, w->largura, w->altura, false, w->tipo != PAINEL_MOLDURA);
+}
+
+// Escreve o texto alinhado na caixa, cortando o que não couber. A coluna de
+// espaçamento depois do último caractere também fica dentro da caixa.
+static void desenhar_texto(const widget_t *w) {
+    char texto[PAINEL_MAX_TEXTO];
+    strcpy(texto, w->texto);
+
+    size_t n = strlen(texto);
+    uint16_t largura = ssd1306_string_width(texto);
+    while (n > 0 && largura >= w->largura) {
+        texto[--n] = '\0';
+        largura = ssd1306_string_width(texto);
+    }
+
+    uint8_t x = w->x;
+    if (w->alinhamento == PAINEL_CENTRO) {
+        x += (w->largura - 1 - largura) / 2;
+    } else if (w->alinhamento == PAINEL_DIREITA) {
+        x += w->largura - 1 - largura;
+    }
+    ssd1306_draw_string(display, texto, x, w->y);
+}
+
+// Linha da tela de um valor do gráfico (o mínimo fica na base)
+static uint8_t grafico_linha(const widget_t *w, int16_t valor) {
+    const grafico_t *g = w->grafico;
+    int32_t v = valor < g->minimo ? g->minimo : (valor > g->maximo ? g->maximo : valor);
+    return w->y + w->altura - 1 - (uint8_t)((v - g->minimo) * (w->altura - 1) / (g->maximo - g->minimo));
+}
+
+// Uma coluna do gráfico: segmento vertical ligando à amostra anterior
+static void grafico_coluna(uint8_t x, uint8_t linha, uint8_t anterior) {
+    uint8_t topo = linha < anterior ? linha : anterior;
+    uint8_t base = linha < anterior ? anterior : linha;
+    ssd1306_rect(display, topo, x, 1, base - topo + 1, true, true);
+}
+
+// Desenho completo, com as amostras alinhadas à direita
+static void desenhar_grafico(widget_t *w) {
+    grafico_t *g = w->grafico;
+    uint8_t visiveis = g->quantidade < w->largura ? g->quantidade : w->largura;
+    uint8_t x = w->x + w->largura - visiveis;
+
+    for (uint8_t n = visiveis; n > 0; n--, x++) {
+        uint8_t linha = grafico_linha(w, g->amostras[amostra_anterior(w, n)]);
+        grafico_coluna(x, g->quantidade > n ? grafico_linha(w, g->amostras[amostra_anterior(w, n + 1)]) : linha, linha);
+    }
+    if (visiveis) {
+        g->ultima_linha = grafico_linha(w, g->amostras[amostra_anterior(w, 1)]);
+    }
+    g->pendentes = 0;
+}
+
+// Desenho incremental: para cada amostra nova, rola a área uma coluna para a
+// esquerda e desenha só a última coluna
+static void rolar_grafico(widget_t *w) {
+    grafico_t *g = w->grafico;
+    uint8_t x = w->x + w->largura - 1;
+
+    for (uint8_t n = g->pendentes; n > 0; n--) {
+        uint8_t linha = grafico_linha(w, g->amostras[amostra_anterior(w, n)]);
+
+        ssd1306_scroll_left(display, w->y, w->x, w->largura, w->altura);
+        ssd1306_rect(display, w->y, x, 1, w->altura, false, true);
+        grafico_coluna(x, g->quantidade > n ? g->ultima_linha : linha, linha);
+        g->ultima_linha = linha;
+    }
+    g->pendentes = 0;
+}
+
+static void desenhar(widget_t *w) {
+    switch (w->tipo) {
+    case PAINEL_ROTULO:
+    case PAINEL_VALOR:
+        desenhar_texto(w);
+        break;
+    case PAINEL_ICONE:
+        if (w->colunas) {
+            ssd1306_draw_bitmap(display, w->colunas, w->largura, w->x, w->y);
+        }
+        break;
+    case PAINEL_BARRA:
+        ssd1306_rect(display, w->y, w->x, w->largura, w->altura, true, false);
+        if (w->altura > 2) {
+            ssd1306_rect(display, w->y + 1, w->x + 1, w->preenchido, w->altura - 2, true, true);
+        }
+        break;
+    case PAINEL_MOLDURA:
+        ssd1306_rect(display, w->y, w->x, w->largura, w->altura, true, false);
+        break;
+    case PAINEL_GRAFICO:
+        desenhar_grafico(w);
+        break;
+    }
+}
+
+// Redesenha os widgets alterados no buffer do display. Retorna se algo foi
+// desenhado; o envio fica com o chamador (ssd1306_send_data_async).
+bool painel_renderizar(void) {
+    // Um gráfico com widgets sobrepostos não pode rolar sem arrastá-los
+    for (uint8_t i = 0; i < num_widgets; i++) {
+        widget_t *w = &widgets[i];
+        if (w->tipo != PAINEL_GRAFICO || w->sujo || !w->desenhado || !w->grafico->pendentes) {
+            continue;
+        }
+        for (uint8_t j = 0; j < num_widgets; j++) {
+            if (j != i && widgets[j].desenhado && sobrepoe(w, &widgets[j])) {
+                w->sujo = true;
+                break;
+            }
+        }
+    }
+
+    // Apagar um widget também apaga o que estiver por cima ou por baixo
+    // dele, e desenhá-lo cobre os vizinhos, que entram no redesenho. Um
+    // widget fora da tela e oculto (ex.: gráfico que mudou de escala) não
+    // mexe em ninguém.
+    bool propagou;
+    do {
+        propagou = false;
+        for (uint8_t i = 0; i < num_widgets; i++) {
+            if (!widgets[i].sujo || (!widgets[i].desenhado && !widgets[i].visivel)) {
+                continue;
+            }
+            for (uint8_t j = 0; j < num_widgets; j++) {
+                if (!widgets[j].sujo && widgets[j].desenhado && sobrepoe(&widgets[i], &widgets[j])) {
+                    widgets[j].sujo = true;
+                    propagou = true;
+                }
+            }
+        }
+    } while (propagou);
+
+    // Apaga tudo antes de desenhar, para um apagamento não cobrir um
+    // widget já redesenhado; o desenho segue a ordem de criação
+    bool desenhou = false;
+    for (uint8_t i = 0; i < num_widgets; i++) {
+        widget_t *w = &widgets[i];
+        if (w->tipo == PAINEL_GRAFICO && !w->sujo && w->desenhado && w->grafico->pendentes) {
+            rolar_grafico(w);
+            desenhou = true;
+        }
+    }
+    for (uint8_t i = 0; i < num_widgets; i++) {
+        widget_t *w = &widgets[i];
+        if (w->sujo && w->desenhado) {
+            apagar(w);
+            w->desenhado = false;
+            desenhou = true;
+        }
+    }
+    for (uint8_t i = 0; i < num_widgets; i++) {
+        widget_t *w = &widgets[i];
+        if (!w->sujo) {
+            continue;
+        }
+        if (w->visivel) {
+            desenhar(w);
+            w->desenhado = true;
+            desenhou = true;
+        }
+        w->sujo = false;
+    }
+    return desenhou;
+}
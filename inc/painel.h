@@ -0,0 +1,55 @@
+#ifndef PAINEL_H
+#define PAINEL_H
+
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+// Camada de widgets do display OLED. Os widgets são criados uma vez e o
+// programa só altera seus valores; painel_renderizar redesenha apenas os que
+// mudaram, e o driver envia somente as regiões alteradas.
+
+#define PAINEL_MAX_WIDGETS 24
+#define PAINEL_MAX_TEXTO   16   // Inclui o terminador
+#define PAINEL_MAX_DECIMAIS 9   // 10^9 ainda cabe no divisor de 32 bits
+#define PAINEL_MAX_GRAFICOS 2
+#define PAINEL_GRAFICO_MAX_COLUNAS 128
+
+typedef enum {
+    PAINEL_ROTULO,      // Texto fixo ou trocado pelo programa
+    PAINEL_VALOR,       // Número com casas decimais e unidade
+    PAINEL_ICONE,       // Bitmap de 8 linhas no formato da fonte
+    PAINEL_BARRA,       // Barra horizontal proporcional a um valor
+    PAINEL_MOLDURA,     // Retângulo vazio
+    PAINEL_GRAFICO      // Linha das últimas amostras, rolando para a esquerda
+} painel_tipo_t;
+
+typedef enum {
+    PAINEL_ESQUERDA,
+    PAINEL_CENTRO,
+    PAINEL_DIREITA
+} painel_alinhamento_t;
+
+// Identificador de um widget (-1 quando não há espaço)
+typedef int8_t painel_id_t;
+
+void painel_init(ssd1306_t *ssd);
+
+painel_id_t painel_rotulo(uint8_t x, uint8_t y, uint8_t largura, painel_alinhamento_t alinhamento, const char *texto);
+painel_id_t painel_valor(uint8_t x, uint8_t y, uint8_t largura, painel_alinhamento_t alinhamento,
+                         uint8_t decimais, const char *unidade);
+painel_id_t painel_icone(uint8_t x, uint8_t y, const uint8_t *colunas, uint8_t largura);
+painel_id_t painel_barra(uint8_t x, uint8_t y, uint8_t largura, uint8_t altura, int32_t minimo, int32_t maximo);
+painel_id_t painel_moldura(uint8_t x, uint8_t y, uint8_t largura, uint8_t altura);
+// Com minimo >= maximo a escala acompanha as amostras
+painel_id_t painel_grafico(uint8_t x, uint8_t y, uint8_t largura, uint8_t altura, int16_t minimo, int16_t maximo);
+
+// Alteram um widget; só o marcam para redesenho se a aparência mudar
+void painel_texto(painel_id_t id, const char *texto);
+void painel_definir_valor(painel_id_t id, int32_t valor);
+void painel_definir_icone(painel_id_t id, const uint8_t *colunas);
+void painel_visivel(painel_id_t id, bool visivel);
+void painel_grafico_adicionar(painel_id_t id, int16_t valor);
+
+bool painel_renderizar(void);
+
+#endif
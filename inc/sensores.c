@@ -0,0 +1,189 @@
+#include "sensores.h"
+#include "hardware/adc.h"
+#include "temp_lut.h"
+#include "ldr.h"
+
+// Canal do ADC do sensor de temperatura interno
+#define ADC_CANAL_TEMPERATURA 4
+
+// Peso de cada nova leitura no filtro da temperatura (1 / 2^shift)
+#define TEMP_FILTRO_SHIFT 4
+
+// Pinos configurados em sensores_init
+static uint pino_trig, pino_echo, canal_ldr;
+
+// Amostrador do ADC: é o único código que usa o ADC, alternando entre o LDR
+// e o sensor de temperatura a cada disparo
+static repeating_timer_t timer_adc;
+static volatile uint32_t temp_bruto_q4 = 0;   // Leitura filtrada, 4 bits extras
+static bool temp_primeira_leitura = true;
+
+// Ajuste de calibração somado a cada leitura de temperatura
+static int16_t calibracao_temperatura = TEMP_CALIBRACAO_CENTI;
+
+// Próximo instante de leitura de cada sensor
+static absolute_time_t proxima_temperatura, proxima_distancia, proxima_luz;
+
+// Leituras em andamento, copiadas para o buffer livre a cada publicação
+static sensores_snapshot_t atual;
+
+// Buffer duplo: a tarefa escreve no buffer não publicado e depois troca o índice.
+// Um leitor nunca vê um retrato pela metade, mesmo interrompendo a escrita.
+static volatile sensores_snapshot_t buffers[2];
+static volatile uint8_t publicado = 0;
+
+// Callback do timer: lê os dois canais e atualiza os filtros
+static bool amostrar_adc(repeating_timer_t *t) {
+    adc_select_input(canal_ldr);
+    ldr_processar(adc_read());
+
+    adc_select_input(ADC_CANAL_TEMPERATURA);
+    uint32_t bruto = adc_read();
+    if (temp_primeira_leitura) {
+        temp_bruto_q4 = bruto << 4;
+        temp_primeira_leitura = false;
+    } else {
+        int32_t diferenca = (int32_t)(bruto << 4) - (int32_t)temp_bruto_q4;
+        temp_bruto_q4 = (uint32_t)((int32_t)temp_bruto_q4 + (diferenca >> TEMP_FILTRO_SHIFT));
+    }
+
+    return true;
+}
+
+// Converte a leitura filtrada do sensor interno para centésimos de °C
+static int16_t temp_read(void) {
+    uint16_t raw_value = (uint16_t)((temp_bruto_q4 + 8) >> 4);
+
+    // Converte pela tabela gerada em temp_lut.h, saturando fora da faixa
+    int indice = (int)raw_value - TEMP_LUT_BRUTO_MIN;
+    if (indice < 0) {
+        indice = 0;
+    } else if (indice >= TEMP_LUT_TAMANHO) {
+        indice = TEMP_LUT_TAMANHO - 1;
+    }
+
+    // A soma é feita em 32 bits e saturada, para um ajuste grande não virar o sinal
+    int32_t temperatura = (int32_t)temp_lut[indice] + calibracao_temperatura;
+    if (temperatura > INT16_MAX) {
+        temperatura = INT16_MAX;
+    } else if (temperatura < INT16_MIN) {
+        temperatura = INT16_MIN;
+    }
+    return (int16_t)temperatura;
+}
+
+// Envia um pulso para o sensor ultrassônico
+static void send_trigger_pulse(void) {
+    gpio_put(pino_trig, 1);
+    sleep_us(10);
+    gpio_put(pino_trig, 0);
+}
+
+// Mede a distância usando o sensor ultrassônico
+static float measure_distance_cm(void) {
+    send_trigger_pulse();
+
+    // Espera o pino ECHO ficar em HIGH
+    while (gpio_get(pino_echo) == 0);
+
+    // Marca o tempo de início
+    absolute_time_t start = get_absolute_time();
+
+    // Espera o pino ECHO voltar para LOW
+    while (gpio_get(pino_echo) == 1);
+
+    // Calcula a duração do pulso em microssegundos
+    absolute_time_t end = get_absolute_time();
+    int64_t pulse_duration = absolute_time_diff_us(start, end);
+
+    // Converte para centímetros (fórmula padrão para sensor HC-SR04)
+    return pulse_duration / 58.0f;
+}
+
+// Copia as leituras atuais para o buffer livre e o publica
+static void publicar(void) {
+    uint8_t livre = publicado ^ 1;
+
+    atual.sequencia++;
+    buffers[livre] = atual;
+
+    __dmb();           // Garante que o conteúdo foi escrito antes da troca
+    publicado = livre;
+}
+
+// Inicializa o ADC e guarda os pinos dos sensores
+void sensores_init(uint trig_pin, uint echo_pin, uint ldr_pin) {
+    pino_trig = trig_pin;
+    pino_echo = echo_pin;
+    canal_ldr = ldr_pin - 26;   // GP26..GP28 correspondem aos canais 0..2
+
+    // Inicializa o ADC para o LDR e o sensor de temperatura
+    adc_init();
+    adc_gpio_init(ldr_pin);
+    adc_set_temp_sensor_enabled(true);
+    ldr_init(LDR_LIMIAR_ESCURO, LDR_LIMIAR_CLARO);
+
+    // Amostragem contínua em segundo plano; a primeira leitura sai já aqui
+    amostrar_adc(NULL);
+    add_repeating_timer_ms(SENSORES_PERIODO_ADC_MS, amostrar_adc, NULL, &timer_adc);
+
+    absolute_time_t agora = get_absolute_time();
+    proxima_temperatura = agora;
+    proxima_distancia = agora;
+    proxima_luz = agora;
+}
+
+// Lê os sensores cujo período venceu e publica um novo retrato.
+// Deve ser chamada apenas pelo loop principal.
+void sensores_tarefa(void) {
+    bool mudou = false;
+    uint32_t agora_ms = to_ms_since_boot(get_absolute_time());
+
+    if (time_reached(proxima_temperatura)) {
+        proxima_temperatura = make_timeout_time_ms(SENSORES_PERIODO_TEMPERATURA_MS);
+        atual.temperatura_centi = temp_read();
+        atual.t_temperatura_ms = agora_ms;
+        atual.amostras_temperatura++;
+        mudou = true;
+    }
+
+    if (time_reached(proxima_distancia)) {
+        proxima_distancia = make_timeout_time_ms(SENSORES_PERIODO_DISTANCIA_MS);
+        atual.distancia_cm = measure_distance_cm();
+        atual.t_distancia_ms = agora_ms;
+        atual.amostras_distancia++;
+        mudou = true;
+    }
+
+    if (time_reached(proxima_luz)) {
+        proxima_luz = make_timeout_time_ms(SENSORES_PERIODO_LUZ_MS);
+        atual.luz = ldr_nivel();
+        atual.lux = ldr_lux();
+        atual.escuro = ldr_escuro();
+        atual.t_luz_ms = agora_ms;
+        atual.amostras_luz++;
+        mudou = true;
+    }
+
+    if (mudou) {
+        publicar();
+    }
+}
+
+// Copia o último retrato publicado. Não acessa o hardware, podendo ser
+// chamada dos callbacks do lwIP sem depender do tempo de ADC ou do sensor.
+void sensores_ler(sensores_snapshot_t *destino) {
+    uint8_t indice;
+
+    // Se a tarefa publicar duas vezes durante a cópia, o buffer lido pode ter
+    // sido reescrito; nesse caso a sequência muda e a cópia é refeita.
+    do {
+        indice = publicado;
+        *destino = buffers[indice];
+    } while (indice != publicado || destino->sequencia != buffers[indice].sequencia);
+}
+
+// Define o ajuste de calibração da temperatura (centésimos de °C)
+void sensores_set_calibracao_temperatura(int16_t ajuste_centi) {
+    calibracao_temperatura = ajuste_centi;
+}
@@ -0,0 +1,46 @@
+#ifndef SENSORES_H
+#define SENSORES_H
+
+#include "pico/stdlib.h"
+
+// Intervalo do amostrador do ADC em segundo plano (LDR e temperatura)
+#define SENSORES_PERIODO_ADC_MS         10
+
+// Intervalos de publicação de cada sensor no retrato (ms)
+#define SENSORES_PERIODO_TEMPERATURA_MS 1000
+#define SENSORES_PERIODO_DISTANCIA_MS   100
+#define SENSORES_PERIODO_LUZ_MS         100
+
+// Ajuste de calibração da temperatura (centésimos de °C) aplicado a cada
+// leitura. Pode ser definido por placa no CMake ou alterado em execução.
+#ifndef TEMP_CALIBRACAO_CENTI
+#define TEMP_CALIBRACAO_CENTI 0
+#endif
+
+// Retrato das últimas leituras dos sensores.
+// É atualizado apenas pela tarefa de sensores (loop principal) e pode ser
+// lido a qualquer momento pelos callbacks de rede sem tocar no hardware.
+typedef struct {
+    int16_t temperatura_centi;      // Temperatura interna do RP2040 (centésimos de °C)
+    float distancia_cm;             // Distância medida pelo sensor ultrassônico
+    uint16_t luz;                   // Nível de luz filtrado (0 = escuro, 4095 = claro)
+    uint32_t lux;                   // Estimativa aproximada da iluminância
+    bool escuro;                    // Estado do ambiente com histerese
+
+    uint32_t t_temperatura_ms;      // Instante da última leitura de cada sensor
+    uint32_t t_distancia_ms;        // (ms desde o boot)
+    uint32_t t_luz_ms;
+
+    uint32_t amostras_temperatura;  // Quantidade de leituras feitas desde o boot
+    uint32_t amostras_distancia;
+    uint32_t amostras_luz;
+
+    uint32_t sequencia;             // Incrementado a cada publicação
+} sensores_snapshot_t;
+
+void sensores_init(uint trig_pin, uint echo_pin, uint ldr_pin);
+void sensores_tarefa(void);
+void sensores_ler(sensores_snapshot_t *destino);
+void sensores_set_calibracao_temperatura(int16_t ajuste_centi);
+
+#endif
@@ -1,47 +1,84 @@
+#include <string.h>
 #include "ssd1306.h"
 #include "font.h"
 
+static void esperar_envio(ssd1306_t *ssd);
+
+static void limpar_alterado(ssd1306_t *ssd) {
+  memset(ssd->dirty_start, 0xFF, sizeof(ssd->dirty_start));
+  memset(ssd->dirty_end, 0x00, sizeof(ssd->dirty_end));
+}
+
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+  // Sem uma especialização do framebuffer nada seria desenhado
+  if (!ssd1306_geometria_suportada(width, height))
+    panic("SSD1306: painel %ux%u sem suporte", width, height);
+
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
+  ssd->external_vcc = external_vcc;
+  ssd->addressing = SSD1306_VERTICAL;
+  // Os painéis de 64 colunas usam o meio da memória de 128 colunas
+  ssd->col_offset = width == 64 ? 32 : 0;
+  limpar_alterado(ssd);
   ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  // O byte de controle fica logo antes dos dados, que assim começam alinhados
+  // em 4 bytes e podem ser escritos em palavras de 32 bits
+  ssd->ram_buffer = (uint8_t *)calloc(ssd->bufsize + 3, sizeof(uint8_t)) + 3;
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+
+  // A memória do display é desconhecida no início: a primeira transmissão
+  // envia tudo, sem comparar com o sent_buffer
+  ssd->sent_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->full_send = true;
+
+  // Pior caso do fluxo: todas as páginas, cada uma com a janela e os dados
+  ssd->tx_stream = malloc(ssd->pages * (7 + 1 + ssd->width) * sizeof(uint16_t));
+  ssd->tx_len = 0;
+  ssd->dma_channel = -1;
+  ssd1306_marcar_alterado(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
+}
+
+// Troca o modo de endereçamento. Deve vir antes de ssd1306_config; o
+// conteúdo do buffer é apagado, pois a posição de cada byte muda.
+void ssd1306_set_addressing(ssd1306_t *ssd, ssd1306_addressing_t addressing) {
+  ssd->addressing = addressing;
+  memset(ssd->ram_buffer + 1, 0, ssd->bufsize - 1);
+  ssd->full_send = true;
+  ssd1306_marcar_alterado(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
 }
 
+// Toda a inicialização vai numa única transação I2C. Multiplex e ligação
+// dos COM seguem a geometria: painéis baixos (128x32, 96x16) usam os COM
+// em sequência, os demais alternados.
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  const uint8_t comandos[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, ssd->addressing,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, ssd->height - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, ssd->width > 2 * ssd->height ? 0x02 : 0x12,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, 0x14,
+    SET_DISP | 0x01,
+  };
+  ssd1306_command_list(ssd, comandos, sizeof(comandos));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  esperar_envio(ssd);
   ssd->port_buffer[1] = command;
   i2c_write_blocking(
     ssd->i2c_port,
@@ -52,66 +89,178 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+// Envia uma sequência de comandos em transações de até SSD1306_MAX_COMMANDS
+// bytes: o byte de controle 0x00 (Co = 0, D/C = 0) faz o controlador tratar
+// todos os bytes seguintes como comandos, em vez de um START, endereço e
+// 0x80 por comando. Um comando dividido entre duas transações continua
+// valendo, pois o controlador só conta os bytes de argumento recebidos.
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t len) {
+  uint8_t buffer[SSD1306_MAX_COMMANDS + 1];
+
+  esperar_envio(ssd);
+
+  buffer[0] = 0x00;
+  while (len > 0) {
+    size_t n = len < SSD1306_MAX_COMMANDS ? len : SSD1306_MAX_COMMANDS;
+    memcpy(buffer + 1, commands, n);
+    i2c_write_blocking(
+      ssd->i2c_port,
+      ssd->address,
+      buffer,
+      n + 1,
+      false
+    );
+    commands += n;
+    len -= n;
+  }
 }
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
-  uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+// Acrescenta um byte ao fluxo do DMA; "stop" encerra a transação I2C e o
+// próximo byte começa outra, com novo START
+static inline void fluxo_byte(ssd1306_t *ssd, uint8_t byte, bool stop) {
+  ssd->tx_stream[ssd->tx_len++] = byte | (stop ? I2C_IC_DATA_CMD_STOP_BITS : 0);
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+// Distância em bytes entre colunas vizinhas no ram_buffer
+static inline size_t passo_coluna(const ssd1306_t *ssd) {
+  return ssd->addressing == SSD1306_VERTICAL ? ssd->pages : 1;
+}
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
-    }
+// Posição do byte da coluna x na página p, sem o byte de controle
+static inline size_t indice(const ssd1306_t *ssd, uint8_t x, uint8_t p) {
+  return ssd->addressing == SSD1306_VERTICAL ? x * ssd->pages + p : p * ssd->width + x;
 }
 
+// Janela de colunas e páginas numa única transação de comandos
+static void fluxo_janela(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+  fluxo_byte(ssd, 0x00, false);
+  fluxo_byte(ssd, SET_COL_ADDR, false);
+  fluxo_byte(ssd, x0, false);
+  fluxo_byte(ssd, x1, false);
+  fluxo_byte(ssd, SET_PAGE_ADDR, false);
+  fluxo_byte(ssd, p0, false);
+  fluxo_byte(ssd, p1, true);
+}
 
+// Monta o fluxo com o que mudou desde a última transmissão. Em cada página,
+// a faixa marcada pelas primitivas é reduzida às colunas que de fato diferem
+// do conteúdo já enviado e vai numa janela SET_COL_ADDR/SET_PAGE_ADDR.
+static void montar_fluxo(ssd1306_t *ssd) {
+  ssd->tx_len = 0;
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
-  }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+  size_t passo = passo_coluna(ssd);
+  for (uint8_t p = 0; p < ssd->pages; ++p) {
+    int inicio = ssd->dirty_start[p];
+    int fim = ssd->dirty_end[p];
+    const uint8_t *atual = ssd->ram_buffer + 1 + indice(ssd, 0, p);
+    const uint8_t *enviado = ssd->sent_buffer + 1 + indice(ssd, 0, p);
+
+    while (!ssd->full_send && inicio <= fim && atual[inicio * passo] == enviado[inicio * passo])
+      ++inicio;
+    while (!ssd->full_send && fim >= inicio && atual[fim * passo] == enviado[fim * passo])
+      --fim;
+    if (inicio > fim)
+      continue;
+
+    fluxo_janela(ssd, inicio + ssd->col_offset, fim + ssd->col_offset, p, p);
+
+    // Nos dois modos uma janela de uma só página recebe as colunas em
+    // sequência; no vertical elas estão espalhadas de "pages" em "pages" bytes
+    fluxo_byte(ssd, 0x40, false);
+    for (int x = inicio; x <= fim; ++x)
+      fluxo_byte(ssd, atual[x * passo], x == fim);
   }
+  ssd->full_send = false;
+  limpar_alterado(ssd);
+}
+
+// Confirma o envio anterior percorrendo o seu fluxo (janela de 7 bytes, 0x40
+// e os dados de cada página). Se o display recusou a transmissão (NACK), o
+// conteúdo dessas janelas é desconhecido: elas voltam a ser marcadas e o
+// próximo envio as transmite inteiras. Senão, os bytes vão para o sent_buffer.
+static void confirmar_fluxo(ssd1306_t *ssd) {
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  bool falhou = hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+
+  for (uint16_t i = 0; i < ssd->tx_len;) {
+    uint8_t x0 = (uint8_t)ssd->tx_stream[i + 2] - ssd->col_offset;
+    uint8_t x1 = (uint8_t)ssd->tx_stream[i + 3] - ssd->col_offset;
+    uint8_t p = ssd->tx_stream[i + 5];
+    i += 8;
 
-  if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
-      }
+    if (falhou) {
+      ssd1306_marcar_alterado(ssd, x0, x1, p, p);
+      i += x1 - x0 + 1;
+      continue;
     }
+    for (int x = x0; x <= x1; ++x)
+      ssd->sent_buffer[1 + indice(ssd, x, p)] = (uint8_t)ssd->tx_stream[i++];
+  }
+
+  if (falhou)
+    ssd->full_send = true;
+  ssd->tx_len = 0;
+}
+
+// Verdadeiro enquanto uma transmissão por DMA ainda não terminou no barramento
+bool ssd1306_busy(ssd1306_t *ssd) {
+  if (ssd->dma_channel < 0)
+    return false;
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  return dma_channel_is_busy(ssd->dma_channel) || hw->txflr != 0 ||
+         (hw->status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+// Espera o envio por DMA terminar e o confirma, antes de usar o barramento
+// de forma bloqueante (que limparia a indicação de NACK do envio)
+static void esperar_envio(ssd1306_t *ssd) {
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
+  confirmar_fluxo(ssd);
+}
+
+// Inicia o envio das regiões alteradas por DMA e retorna sem esperar o I2C.
+// O fluxo é uma cópia: ram_buffer pode ser redesenhado durante o envio.
+// Retorna false se o envio anterior ainda estiver em andamento; as
+// alterações continuam marcadas e saem na próxima chamada. O envio anterior
+// só é dado como entregue aqui, depois que terminou no barramento.
+bool ssd1306_send_data_async(ssd1306_t *ssd) {
+  if (ssd1306_busy(ssd))
+    return false;
+
+  confirmar_fluxo(ssd);
+  montar_fluxo(ssd);
+  if (ssd->tx_len == 0)
+    return true;   // Quadro idêntico ao anterior
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  if (ssd->dma_channel < 0) {
+    ssd->dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(ssd->dma_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+    dma_channel_configure(ssd->dma_channel, &c, &hw->data_cmd, ssd->tx_stream, 0, false);
   }
+
+  // Endereço do display e limpeza de um NACK anterior, que bloquearia a FIFO
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = I2C_IC_ENABLE_ENABLE_BITS;
+  (void)hw->clr_tx_abrt;
+
+  dma_channel_transfer_from_buffer_now(ssd->dma_channel, ssd->tx_stream, ssd->tx_len);
+  return true;
+}
+
+// Versão bloqueante: envia as regiões alteradas e espera o fim da transmissão
+void ssd1306_send_data(ssd1306_t *ssd) {
+  while (!ssd1306_send_data_async(ssd))
+    tight_loop_contents();
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
@@ -142,59 +291,58 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
     }
 }
 
+// Busca o glifo direto pelo código Latin-1 do caractere
+static inline const fonte_glifo_t *glifo_de(char c)
+{
+  return &fonte_glifos[(uint8_t)c];
+}
 
-void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+// Função para desenhar um caractere
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  const fonte_glifo_t *g = glifo_de(c);
+  ssd1306_draw_bitmap(ssd, &fonte_colunas[g->inicio], g->largura, x, y);
 }
 
-void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+// Largura em pixels de um caractere, sem o espaçamento
+uint8_t ssd1306_char_width(char c)
+{
+  return glifo_de(c)->largura;
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+// Largura em pixels de uma string numa única linha
+uint16_t ssd1306_string_width(const char *str)
 {
-  uint16_t index = 0;
-  char ver=c;
-  if (c >= 'A' && c <= 'Z')
-  {
-    index = (c - 'A' + 11) * 8; // Para letras maiúsculas
-  }else  if (c >= '0' && c <= '9')
-  {
-    index = (c - '0' + 1) * 8; // Adiciona o deslocamento necessário
-  }
-  else  if (c >= 'a' && c <= 'z')
-  {
-    index = (c - 'a' + 37) * 8; // Adiciona o deslocamento necessário
-  }
-  
-  for (uint8_t i = 0; i < 8; ++i)
+  uint16_t largura = 0;
+  while (*str)
   {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
-    }
+    largura += glifo_de(*str++)->largura + FONTE_ESPACAMENTO;
   }
+  return largura > 0 ? largura - FONTE_ESPACAMENTO : 0;
 }
 
 // Função para desenhar uma string
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
 {
+  static const uint8_t espacamento[FONTE_ESPACAMENTO] = {0};
+
   while (*str)
   {
-    ssd1306_draw_char(ssd, *str++, x, y);
-    x += 8;
-    if (x + 8 >= ssd->width)
+    uint8_t largura = glifo_de(*str)->largura;
+    if (x + largura > ssd->width)
     {
       x = 0;
-      y += 8;
+      y += FONTE_ALTURA;
     }
-    if (y + 8 >= ssd->height)
+    if (y + FONTE_ALTURA > ssd->height)
     {
       break;
     }
+    ssd1306_draw_char(ssd, *str++, x, y);
+    x += largura;
+
+    // Limpa a coluna entre caracteres para não sobrar texto anterior
+    ssd1306_draw_bitmap(ssd, espacamento, FONTE_ESPACAMENTO, x, y);
+    x += FONTE_ESPACAMENTO;
   }
 }
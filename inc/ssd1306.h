@@ -1,10 +1,20 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
 
 #define WIDTH 128
 #define HEIGHT 64
 
+// Comandos por transação em ssd1306_command_list (listas maiores vão em várias)
+#define SSD1306_MAX_COMMANDS 32
+
+// Maior número de páginas (8 linhas cada) suportado pelo controle de regiões alteradas
+#define SSD1306_MAX_PAGES 8
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -25,25 +35,75 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+// Modo de endereçamento da memória do display (argumento de SET_MEM_ADDR)
+typedef enum {
+  SSD1306_HORIZONTAL = 0x00,   // Página a página: colunas vizinhas são bytes vizinhos
+  SSD1306_VERTICAL = 0x01      // Coluna a coluna: as páginas de uma coluna são bytes vizinhos
+} ssd1306_addressing_t;
+
 typedef struct {
   uint8_t width, height, pages, address;
+  uint8_t addressing;                      // ssd1306_addressing_t do ram_buffer e do display
+  uint8_t col_offset;                      // Primeira coluna da memória ligada ao painel
   i2c_inst_t *i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  uint8_t *sent_buffer;                    // Conteúdo já transmitido ao display
+  uint16_t *tx_stream;                     // Palavras para o DATA_CMD do I2C (byte + STOP)
+  uint16_t tx_len;                         // Fluxo do último envio, confirmado no próximo
+  bool full_send;                          // Próximo envio ignora o sent_buffer nas faixas marcadas
+  int dma_channel;                         // Canal que alimenta o I2C (-1 até o 1º envio)
+  uint8_t dirty_start[SSD1306_MAX_PAGES];  // Colunas alteradas em cada página
+  uint8_t dirty_end[SSD1306_MAX_PAGES];    // (início > fim: página sem alterações)
 } ssd1306_t;
 
+// Marca as colunas x0..x1 das páginas p0..p1 como alteradas. Usada pelo
+// envio (ssd1306.c) e pelas primitivas de desenho (framebuffer.hpp).
+static inline void ssd1306_marcar_alterado(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+  for (uint8_t p = p0; p <= p1; ++p) {
+    if (x0 < ssd->dirty_start[p])
+      ssd->dirty_start[p] = x0;
+    if (x1 > ssd->dirty_end[p])
+      ssd->dirty_end[p] = x1;
+  }
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// As primitivas de desenho (pixel, fill, rect, hline, vline, draw_bitmap e
+// scroll_left) ficam em ssd1306_framebuffer.cpp, especializadas para os
+// painéis 128x64, 128x32, 96x16 e 64x48, nos dois modos de endereçamento.
+// ssd1306_init recusa as demais geometrias.
+bool ssd1306_geometria_suportada(uint8_t width, uint8_t height);
+
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_set_addressing(ssd1306_t *ssd, ssd1306_addressing_t addressing);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t len);
 void ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_send_data_async(ssd1306_t *ssd);
+bool ssd1306_busy(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
+void ssd1306_scroll_left(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height);
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *colunas, uint8_t largura, uint8_t x, uint8_t y);
+uint8_t ssd1306_char_width(char c);
+uint16_t ssd1306_string_width(const char *str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,78 @@
+// Primitivas de desenho da API ssd1306_* (C), implementadas sobre o
+// Framebuffer especializado para cada geometria de painel suportada.
+// A geometria do ssd1306_t escolhe a especialização uma vez por chamada;
+// dentro dela índices, passos e limites são constantes.
+
+#include "framebuffer.hpp"
+
+namespace {
+
+// Painéis SSD1306 comuns, em cada modo de endereçamento
+template <Enderecamento Modo> using Painel128x64 = Framebuffer<128, 64, Modo>;
+template <Enderecamento Modo> using Painel128x32 = Framebuffer<128, 32, Modo>;
+template <Enderecamento Modo> using Painel96x16 = Framebuffer<96, 16, Modo>;
+template <Enderecamento Modo> using Painel64x48 = Framebuffer<64, 48, Modo>;
+
+template <Enderecamento Modo, typename F>
+inline void despachar_geometria(ssd1306_t *ssd, F &&desenho) {
+  if (Painel128x64<Modo>::compativel(ssd))
+    desenho(Painel128x64<Modo>(ssd));
+  else if (Painel128x32<Modo>::compativel(ssd))
+    desenho(Painel128x32<Modo>(ssd));
+  else if (Painel96x16<Modo>::compativel(ssd))
+    desenho(Painel96x16<Modo>(ssd));
+  else if (Painel64x48<Modo>::compativel(ssd))
+    desenho(Painel64x48<Modo>(ssd));
+}
+
+// Executa "desenho" com o framebuffer da geometria e do endereçamento do
+// display. Outras geometrias não chegam aqui: ssd1306_init as recusa.
+template <typename F>
+inline void despachar(ssd1306_t *ssd, F &&desenho) {
+  if (ssd->addressing == SSD1306_VERTICAL)
+    despachar_geometria<Enderecamento::Vertical>(ssd, desenho);
+  else
+    despachar_geometria<Enderecamento::Horizontal>(ssd, desenho);
+}
+
+}
+
+extern "C" {
+
+bool ssd1306_geometria_suportada(uint8_t width, uint8_t height) {
+  using M = Enderecamento;
+  return Painel128x64<M::Vertical>::compativel(width, height) || Painel128x32<M::Vertical>::compativel(width, height) ||
+         Painel96x16<M::Vertical>::compativel(width, height) || Painel64x48<M::Vertical>::compativel(width, height);
+}
+
+void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  despachar(ssd, [&](auto fb) { fb.pixel(x, y, value); });
+}
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  despachar(ssd, [&](auto fb) { fb.preencher(value); });
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  despachar(ssd, [&](auto fb) { fb.retangulo(top, left, width, height, value, fill); });
+}
+
+void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  if (x0 <= x1)
+    despachar(ssd, [&](auto fb) { fb.retangulo(y, x0, x1 - x0 < 255 ? x1 - x0 + 1 : 255, 1, value, true); });
+}
+
+void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  if (y0 <= y1)
+    despachar(ssd, [&](auto fb) { fb.retangulo(y0, x, 1, y1 - y0 < 255 ? y1 - y0 + 1 : 255, value, true); });
+}
+
+void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *colunas, uint8_t largura, uint8_t x, uint8_t y) {
+  despachar(ssd, [&](auto fb) { fb.bitmap(colunas, largura, x, y); });
+}
+
+void ssd1306_scroll_left(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height) {
+  despachar(ssd, [&](auto fb) { fb.rolar_esquerda(top, left, width, height); });
+}
+
+}
@@ -0,0 +1,42 @@
+// Tabela de conversão do sensor de temperatura interno do RP2040.
+// Cada posição corresponde a uma leitura bruta de 12 bits do ADC e guarda a
+// temperatura em centésimos de grau Celsius. A tabela é gerada pelo
+// pré-processador, então nenhuma operação de ponto flutuante é feita em tempo
+// de execução.
+//
+// Só a faixa de leituras 512..1535 é tabelada (cerca de +197 °C a -281 °C),
+// que cobre com folga a faixa de operação do chip e cabe em int16_t.
+// Leituras fora dela são saturadas nas extremidades.
+//
+// Fórmula da documentação do RP2040:
+//   T = 27 - (V - 0,706) / 0,001721,  V = bruto * 3,3 / 4096
+// Em centésimos, com apenas inteiros:
+//   T = 2700 - (bruto * 330000000 - 0,706 * 4096 * 1e8) / (4096 * 1721)
+
+#ifndef TEMP_LUT_H
+#define TEMP_LUT_H
+
+#include <stdint.h>
+
+#define TEMP_LUT_BRUTO_MIN 512
+#define TEMP_LUT_TAMANHO   1024
+
+// Divisão inteira com arredondamento para o inteiro mais próximo
+#define TEMP_LUT_DIV_ARRED(n, d) ((n) >= 0 ? ((n) + (d) / 2) / (d) : -((-(n) + (d) / 2) / (d)))
+
+#define TEMP_LUT_CENTI(bruto) \
+  ((int16_t)(2700 - TEMP_LUT_DIV_ARRED((long long)(bruto) * 330000000LL - 289177600000LL, 7049216LL)))
+
+// Expansão das entradas em blocos de potências de 4
+#define TEMP_LUT_1(n)    TEMP_LUT_CENTI(n),
+#define TEMP_LUT_4(n)    TEMP_LUT_1(n)    TEMP_LUT_1((n) + 1)      TEMP_LUT_1((n) + 2)      TEMP_LUT_1((n) + 3)
+#define TEMP_LUT_16(n)   TEMP_LUT_4(n)    TEMP_LUT_4((n) + 4)      TEMP_LUT_4((n) + 8)      TEMP_LUT_4((n) + 12)
+#define TEMP_LUT_64(n)   TEMP_LUT_16(n)   TEMP_LUT_16((n) + 16)    TEMP_LUT_16((n) + 32)    TEMP_LUT_16((n) + 48)
+#define TEMP_LUT_256(n)  TEMP_LUT_64(n)   TEMP_LUT_64((n) + 64)    TEMP_LUT_64((n) + 128)   TEMP_LUT_64((n) + 192)
+#define TEMP_LUT_1024(n) TEMP_LUT_256(n)  TEMP_LUT_256((n) + 256)  TEMP_LUT_256((n) + 512)  TEMP_LUT_256((n) + 768)
+
+static const int16_t temp_lut[TEMP_LUT_TAMANHO] = {
+  TEMP_LUT_1024(TEMP_LUT_BRUTO_MIN)
+};
+
+#endif
@@ -0,0 +1,334 @@
+#!/usr/bin/env python3
+"""Gera inc/font.h com a fonte de 8 pixels de altura do display SSD1306.
+
+Cobre o ASCII imprivel (32-126) e o Latin-1 (160-255), que e a codificacao
+dos textos em Projeto_webserver.c. Cada glifo e guardado com a sua largura
+real (fonte proporcional), uma coluna por byte com o bit 0 em cima - o mesmo
+formato das paginas do display.
+
+- Letras e digitos: os glifos originais do projeto
+- Pontuacao e simbolos: desenhados abaixo, linha a linha
+- Letras acentuadas: compostas a partir da letra base e do acento
+
+Uso: python3 tools/gerar_fonte.py > inc/font.h
+"""
+
+ALTURA = 8
+ESPACO = 2          # Largura do espaco em branco
+SUBSTITUTO = '?'    # Glifo usado para codigos sem desenho
+
+# Glifos originais (colunas de 8 bits, bit 0 em cima)
+BASE = {
+    '0': [0x3e, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3e, 0x00],
+    '1': [0x00, 0x00, 0x42, 0x7f, 0x40, 0x00, 0x00, 0x00],
+    '2': [0x30, 0x49, 0x49, 0x49, 0x49, 0x46, 0x00, 0x00],
+    '3': [0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00],
+    '4': [0x3f, 0x20, 0x20, 0x78, 0x20, 0x20, 0x00, 0x00],
+    '5': [0x4f, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00],
+    '6': [0x3f, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00],
+    '7': [0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00],
+    '8': [0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00],
+    '9': [0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00],
+    'A': [0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00],
+    'B': [0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00],
+    'C': [0x7e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x00],
+    'D': [0x7f, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x00],
+    'E': [0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00],
+    'F': [0x7f, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, 0x00],
+    'G': [0x7f, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, 0x00],
+    'H': [0x7f, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7f, 0x00],
+    'I': [0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00],
+    'J': [0x21, 0x41, 0x41, 0x3f, 0x01, 0x01, 0x01, 0x00],
+    'K': [0x00, 0x7f, 0x08, 0x08, 0x14, 0x22, 0x41, 0x00],
+    'L': [0x7f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00],
+    'M': [0x7f, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7f, 0x00],
+    'N': [0x7f, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7f, 0x00],
+    'O': [0x3e, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3e, 0x00],
+    'P': [0x7f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x00],
+    'Q': [0x3e, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7e, 0x00],
+    'R': [0x7f, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0e, 0x00],
+    'S': [0x46, 0x49, 0x49, 0x49, 0x49, 0x30, 0x00, 0x00],
+    'T': [0x01, 0x01, 0x01, 0x7f, 0x01, 0x01, 0x01, 0x00],
+    'U': [0x3f, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3f, 0x00],
+    'V': [0x0f, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0f, 0x00],
+    'W': [0x7f, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7f, 0x00],
+    'X': [0x00, 0x41, 0x22, 0x14, 0x14, 0x22, 0x41, 0x00],
+    'Y': [0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, 0x00],
+    'Z': [0x41, 0x61, 0x59, 0x45, 0x43, 0x41, 0x00, 0x00],
+    'a': [0x00, 0x18, 0x24, 0x24, 0x24, 0x3c, 0x00, 0x00],
+    'b': [0x00, 0x7e, 0x24, 0x24, 0x24, 0x24, 0x18, 0x00],
+    'c': [0x00, 0x1c, 0x22, 0x22, 0x22, 0x22, 0x00, 0x00],
+    'd': [0x00, 0x18, 0x24, 0x24, 0x24, 0x24, 0x7e, 0x00],
+    'e': [0x00, 0x1c, 0x22, 0x2e, 0x2a, 0x2a, 0x1c, 0x00],
+    'f': [0x00, 0x08, 0x7e, 0x09, 0x01, 0x02, 0x00, 0x00],
+    'g': [0x00, 0x18, 0xa4, 0xa4, 0xa4, 0x9c, 0x78, 0x00],
+    'h': [0x00, 0x7e, 0x08, 0x04, 0x04, 0x3c, 0x20, 0x00],
+    'i': [0x00, 0x00, 0x24, 0x3d, 0x20, 0x00, 0x00, 0x00],
+    'j': [0x00, 0x00, 0x40, 0x80, 0x84, 0x7d, 0x00, 0x00],
+    'k': [0x00, 0x7e, 0x08, 0x14, 0x24, 0x20, 0x00, 0x00],
+    'l': [0x00, 0x00, 0x02, 0x7e, 0x20, 0x00, 0x00, 0x00],
+    'm': [0x00, 0x3c, 0x04, 0x18, 0x04, 0x3c, 0x00, 0x00],
+    'n': [0x00, 0x3c, 0x08, 0x04, 0x04, 0x3c, 0x00, 0x00],
+    'o': [0x00, 0x18, 0x24, 0x24, 0x24, 0x24, 0x18, 0x00],
+    'p': [0x00, 0xfc, 0x24, 0x24, 0x24, 0x18, 0x00, 0x00],
+    'q': [0x00, 0x18, 0x24, 0x24, 0x24, 0x28, 0xfc, 0x00],
+    'r': [0x00, 0x3c, 0x08, 0x04, 0x04, 0x08, 0x00, 0x00],
+    's': [0x00, 0x28, 0x2c, 0x34, 0x34, 0x14, 0x00, 0x00],
+    't': [0x00, 0x04, 0x1e, 0x24, 0x20, 0x10, 0x00, 0x00],
+    'u': [0x00, 0x1c, 0x20, 0x20, 0x20, 0x3c, 0x00, 0x00],
+    'v': [0x00, 0x0c, 0x10, 0x20, 0x10, 0x0c, 0x00, 0x00],
+    'w': [0x00, 0x3c, 0x10, 0x08, 0x10, 0x3c, 0x00, 0x00],
+    'x': [0x00, 0x24, 0x18, 0x18, 0x24, 0x00, 0x00, 0x00],
+    'y': [0x00, 0x1c, 0xa0, 0xa0, 0xa0, 0x7c, 0x00, 0x00],
+    'z': [0x00, 0x24, 0x34, 0x2c, 0x24, 0x24, 0x00, 0x00],
+}
+
+# Simbolos desenhados linha a linha: (primeira linha, [linhas])
+DESENHOS = {
+    '!': (0, ["#", "#", "#", "#", "#", ".", "#"]),
+    '"': (0, ["#.#", "#.#"]),
+    '#': (1, [".#.#.", "#####", ".#.#.", "#####", ".#.#."]),
+    '$': (0, ["..#..", ".####", "#.#..", ".###.", "..#.#", "####.", "..#.."]),
+    '%': (1, ["##..#", "##.#.", "..#..", ".#.##", "#..##"]),
+    '&': (0, [".##..", "#..#.", "#.#..", ".#...", "#.#.#", "#..#.", ".##.#"]),
+    "'": (0, ["#", "#"]),
+    '(': (0, [".#", "#.", "#.", "#.", "#.", "#.", ".#"]),
+    ')': (0, ["#.", ".#", ".#", ".#", ".#", ".#", "#."]),
+    '*': (1, ["#.#.#", ".###.", "#.#.#"]),
+    '+': (1, ["..#..", "..#..", "#####", "..#..", "..#.."]),
+    ',': (5, [".#", ".#", "#."]),
+    '-': (3, ["####"]),
+    '.': (6, ["#"]),
+    '/': (1, ["....#", "...#.", "..#..", ".#...", "#...."]),
+    ':': (2, ["#", ".", ".", "#"]),
+    ';': (2, [".#", "..", "..", ".#", "#."]),
+    '<': (0, ["...#", "..#.", ".#..", "#...", ".#..", "..#.", "...#"]),
+    '=': (2, ["####", "....", "####"]),
+    '>': (0, ["#...", ".#..", "..#.", "...#", "..#.", ".#..", "#..."]),
+    '?': (0, [".###.", "#...#", "....#", "...#.", "..#..", ".....", "..#.."]),
+    '@': (0, [".###.", "#...#", "#.###", "#.#.#", "#.###", "#....", ".####"]),
+    '[': (0, ["##", "#.", "#.", "#.", "#.", "#.", "##"]),
+    '\\': (1, ["#....", ".#...", "..#..", "...#.", "....#"]),
+    ']': (0, ["##", ".#", ".#", ".#", ".#", ".#", "##"]),
+    '^': (0, ["..#..", ".#.#.", "#...#"]),
+    '_': (7, ["#####"]),
+    '`': (0, ["#.", ".#"]),
+    '{': (0, ["..#", ".#.", ".#.", "#..", ".#.", ".#.", "..#"]),
+    '|': (0, ["#", "#", "#", "#", "#", "#", "#", "#"]),
+    '}': (0, ["#..", ".#.", ".#.", "..#", ".#.", ".#.", "#.."]),
+    '~': (2, [".#...", "#.#.#", "...#."]),
+    '¡': (0, ["#", ".", "#", "#", "#", "#", "#"]),
+    '¢': (1, ["..#..", ".####", "#.#..", "#.#..", ".####", "..#.."]),
+    '£': (0, ["..##.", ".#..#", ".#...", "###..", ".#...", ".#...", "#####"]),
+    '¤': (1, ["#...#", ".###.", ".#.#.", ".###.", "#...#"]),
+    '¥': (0, ["#...#", ".#.#.", "..#..", "#####", "..#..", "#####", "..#.."]),
+    '¦': (0, ["#", "#", "#", ".", "#", "#", "#"]),
+    '§': (0, [".###", "#...", ".##.", "#..#", ".##.", "...#", "###."]),
+    '¨': (0, ["#.#"]),
+    '©': (0, [".#####.", "#.....#", "#..##.#", "#.#...#", "#..##.#", "#.....#", ".#####."]),
+    'ª': (0, [".##", "#.#", ".##", "...", "###"]),
+    '«': (1, ["..#..#", ".#..#.", "#..#..", ".#..#.", "..#..#"]),
+    '¬': (3, ["#####", "....#"]),
+    '\xad': (3, ["####"]),
+    '®': (0, [".#####.", "#.....#", "#.##..#", "#.#.#.#", "#.##..#", "#.#.#.#", ".#####."]),
+    '¯': (0, ["#####"]),
+    '°': (0, [".#.", "#.#", ".#."]),
+    '±': (0, ["..#..", "..#..", "#####", "..#..", "..#..", ".....", "#####"]),
+    '²': (0, ["##.", "..#", ".#.", "###"]),
+    '³': (0, ["###", ".##", "..#", "###"]),
+    '´': (0, [".#", "#."]),
+    'µ': (2, ["#..#", "#..#", "#..#", "###.", "#...", "#..."]),
+    '¶': (0, [".####", "###.#", "###.#", ".##.#", "..#.#", "..#.#", "..#.#"]),
+    '·': (3, ["#"]),
+    '¸': (6, [".#", "#."]),
+    '¹': (0, [".#.", "##.", ".#.", "###"]),
+    'º': (0, [".#.", "#.#", ".#.", "...", "###"]),
+    '»': (1, ["#..#..", ".#..#.", "..#..#", ".#..#.", "#..#.."]),
+    '¼': (0, ["#...#..", "#..#...", "#.#....", "..#.#..", ".#.##..", "#..###.", "....#.."]),
+    '½': (0, ["#...#..", "#..#...", "#.#....", "..#.##.", ".#...#.", "#...#..", "....###"]),
+    '¾': (0, ["##..#..", ".#.#...", "##.#...", "..#.#..", ".#.##..", "#..###.", "....#.."]),
+    '¿': (0, ["..#..", ".....", "..#..", ".#...", "#....", "#...#", ".###."]),
+    'Æ': (0, [".#####", "#.#...", "#.#...", "######", "#.#...", "#.#...", "#.####"]),
+    'Ð': (0, ["####.", ".#..#", ".#..#", "###.#", ".#..#", ".#..#", "####."]),
+    '×': (1, ["#...#", ".#.#.", "..#..", ".#.#.", "#...#"]),
+    'Ø': (0, [".####", "#..##", "#.#.#", "#.#.#", "#.#.#", "##..#", "####."]),
+    'Þ': (0, ["#....", "####.", "#...#", "#...#", "####.", "#....", "#...."]),
+    'ß': (0, [".##..", "#..#.", "#..#.", "#.#..", "#..#.", "#..#.", "#.#.."]),
+    'æ': (1, [".##.##.", "...#..#", ".######", "#..#...", ".##.###"]),
+    'ð': (0, [".##..", "..##.", ".###.", "#..#.", "#..#.", ".##.."]),
+    '÷': (1, ["..#..", ".....", "#####", ".....", "..#.."]),
+    'ø': (1, [".###.", "#..##", "#.#.#", "##..#", ".###."]),
+    'þ': (1, ["#...", "###.", "#..#", "#..#", "###.", "#...", "#..."]),
+}
+
+# Acentos: versao de duas linhas e, quando falta espaco acima da letra,
+# versao de uma linha
+ACENTOS = {
+    'grave':      ([".#...", "..#.."], [".#..."]),
+    'agudo':      (["...#.", "..#.."], ["...#."]),
+    'circunflexo': (["..#..", ".#.#."], [".###."]),
+    'til':        ([".##.#", "#..#."], ["##.##"]),
+    'trema':      ([".....", ".#.#."], [".#.#."]),
+    'anel':       ([".###.", ".#.#."], ["..#.."]),
+}
+CEDILHA = ["..#..", ".#..."]
+
+# Letras compostas do Latin-1: codigo -> (letra base, acento)
+COMPOSTAS = {}
+for base, inicio in (('A', 0xC0), ('a', 0xE0)):
+    for i, acento in enumerate(('grave', 'agudo', 'circunflexo', 'til', 'trema', 'anel')):
+        COMPOSTAS[inicio + i] = (base, acento)
+for base, inicio in (('E', 0xC8), ('e', 0xE8), ('I', 0xCC), ('i', 0xEC)):
+    for i, acento in enumerate(('grave', 'agudo', 'circunflexo', 'trema')):
+        COMPOSTAS[inicio + i] = (base, acento)
+for base, inicio in (('O', 0xD2), ('o', 0xF2)):
+    for i, acento in enumerate(('grave', 'agudo', 'circunflexo', 'til', 'trema')):
+        COMPOSTAS[inicio + i] = (base, acento)
+for base, inicio in (('U', 0xD9), ('u', 0xF9)):
+    for i, acento in enumerate(('grave', 'agudo', 'circunflexo', 'trema')):
+        COMPOSTAS[inicio + i] = (base, acento)
+COMPOSTAS[0xC7] = ('C', 'cedilha')
+COMPOSTAS[0xE7] = ('c', 'cedilha')
+COMPOSTAS[0xD1] = ('N', 'til')
+COMPOSTAS[0xF1] = ('n', 'til')
+COMPOSTAS[0xDD] = ('Y', 'agudo')
+COMPOSTAS[0xFD] = ('y', 'agudo')
+COMPOSTAS[0xFF] = ('y', 'trema')
+
+
+def desenho_para_colunas(primeira, linhas):
+    largura = max(len(l) for l in linhas)
+    colunas = [0] * largura
+    for r, linha in enumerate(linhas):
+        for c, ponto in enumerate(linha):
+            if ponto == '#':
+                colunas[c] |= 1 << (primeira + r)
+    return colunas
+
+
+def linhas_usadas(colunas):
+    tudo = 0
+    for c in colunas:
+        tudo |= c
+    return [r for r in range(ALTURA) if tudo & (1 << r)]
+
+
+def aparar(colunas):
+    """Remove as colunas vazias das bordas (largura proporcional)."""
+    inicio = 0
+    while inicio < len(colunas) and colunas[inicio] == 0:
+        inicio += 1
+    fim = len(colunas)
+    while fim > inicio and colunas[fim - 1] == 0:
+        fim -= 1
+    return colunas[inicio:fim]
+
+
+def sobrepor(colunas, desenho, primeira):
+    """Desenha o acento centralizado sobre a tinta da letra."""
+    acento = desenho_para_colunas(primeira, desenho)
+    tinta = [i for i, c in enumerate(colunas) if c]
+    centro = (tinta[0] + tinta[-1] + 1) // 2
+    x0 = centro - len(acento) // 2
+    if x0 < 0:
+        colunas = [0] * -x0 + colunas
+        x0 = 0
+    while len(colunas) < x0 + len(acento):
+        colunas.append(0)
+    for i, c in enumerate(acento):
+        colunas[x0 + i] |= c
+    return colunas
+
+
+def compor(base, acento):
+    colunas = list(BASE[base])
+    if base == 'i':
+        colunas = [c & ~0x03 for c in colunas]   # i sem o pingo
+
+    usadas = linhas_usadas(colunas)
+    topo, fundo = usadas[0], usadas[-1]
+
+    if acento == 'cedilha':
+        livres = ALTURA - 1 - fundo
+        return sobrepor(colunas, CEDILHA[:livres], fundo + 1)
+
+    # Desce a letra o necessario (e possivel) para caber um acento de duas linhas
+    descer = min(max(0, 2 - topo), ALTURA - 1 - fundo)
+    colunas = [(c << descer) & 0xFF for c in colunas]
+    topo += descer
+
+    duas, uma = ACENTOS[acento]
+    if topo >= 2:
+        return sobrepor(colunas, duas, topo - 2)
+    return sobrepor(colunas, uma, topo - 1)
+
+
+def glifo(codigo):
+    ch = chr(codigo)
+    if ch in BASE:
+        return aparar(BASE[ch])
+    if ch in DESENHOS:
+        return aparar(desenho_para_colunas(*DESENHOS[ch]))
+    if codigo in COMPOSTAS:
+        return aparar(compor(*COMPOSTAS[codigo]))
+    if codigo in (0x20, 0xA0):
+        return [0] * ESPACO
+    return None
+
+
+def nome(codigo):
+    if codigo == 0x5C:
+        return "'\\\\'"
+    if codigo < 0x80:
+        return "'%s'" % chr(codigo)
+    return "0x%02X" % codigo
+
+
+def main():
+    colunas = []
+    glifos = {}
+    linhas = []
+    for codigo in list(range(0x20, 0x7F)) + list(range(0xA0, 0x100)):
+        g = glifo(codigo)
+        if g is None:
+            continue
+        glifos[codigo] = (len(colunas), len(g))
+        linhas.append("    %s  // %s" % (" ".join("0x%02x," % c for c in g) if g else "", nome(codigo)))
+        colunas.extend(g)
+
+    substituto = glifos[ord(SUBSTITUTO)]
+
+    print("// Arquivo gerado por tools/gerar_fonte.py - nao editar manualmente.")
+    print("// Fonte proporcional de %d pixels de altura: ASCII imprimivel e Latin-1." % ALTURA)
+    print("// Cada byte e uma coluna com o bit 0 em cima, no formato das paginas do SSD1306.")
+    print()
+    print("#ifndef FONT_H")
+    print("#define FONT_H")
+    print()
+    print("#include <stdint.h>")
+    print()
+    print("#define FONTE_ALTURA %d" % ALTURA)
+    print("#define FONTE_ESPACAMENTO 1   // Coluna vazia entre caracteres")
+    print()
+    print("// Posicao das colunas de um glifo em fonte_colunas e sua largura")
+    print("typedef struct {")
+    print("  uint16_t inicio;")
+    print("  uint8_t largura;")
+    print("} fonte_glifo_t;")
+    print()
+    print("static const uint8_t fonte_colunas[%d] = {" % len(colunas))
+    print("\n".join(l.rstrip() if not l.strip().startswith("//") else l for l in linhas))
+    print("};")
+    print()
+    print("// Indexada pelo codigo Latin-1 do caractere; codigos sem desenho usam '%s'" % SUBSTITUTO)
+    print("static const fonte_glifo_t fonte_glifos[256] = {")
+    for codigo in range(256):
+        inicio, largura = glifos.get(codigo, substituto)
+        print("  { %4d, %d },  // %s" % (inicio, largura, nome(codigo) if codigo in glifos else "0x%02X" % codigo))
+    print("};")
+    print()
+    print("#endif")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+"""Gera inc/gamma_lut.h com as tabelas de cor da matriz de LEDs.
+
+- gamma16_lut: corrige o brilho percebido (saida = 255 * (entrada / 255) ^ GAMA)
+  em ponto fixo 8.8, para o dithering temporal
+- escala_lut: multiplicador Q16 de cada nivel de brilho (brilho * 65536 / 255),
+  evitando a divisao por 255 ao aplicar o brilho de um comodo
+
+Uso: python3 tools/gerar_gamma_lut.py > inc/gamma_lut.h
+"""
+
+GAMA = 2.2
+
+
+def tabela(nome, tipo, valores, por_linha):
+    linhas = []
+    for i in range(0, len(valores), por_linha):
+        linhas.append("    " + ", ".join(str(v) for v in valores[i:i + por_linha]) + ",")
+    return "static const %s %s[256] = {\n%s\n};\n" % (tipo, nome, "\n".join(linhas))
+
+
+def main():
+    gamma16 = [round(255 * 256 * (i / 255) ** GAMA) for i in range(256)]
+    escala = [(b * 65536 + 127) // 255 for b in range(256)]
+
+    print("// Arquivo gerado por tools/gerar_gamma_lut.py - nao editar manualmente.")
+    print("// Gama %.1f para os canais da matriz e escala Q16 dos niveis de brilho." % GAMA)
+    print()
+    print("#ifndef GAMMA_LUT_H")
+    print("#define GAMMA_LUT_H")
+    print()
+    print("#include <stdint.h>")
+    print()
+    print(tabela("gamma16_lut", "uint16_t", gamma16, 12))
+    print(tabela("escala_lut", "uint32_t", escala, 8))
+    print("#endif")
+
+
+if __name__ == "__main__":
+    main()